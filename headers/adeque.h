@@ -10,6 +10,10 @@
 #ifndef _ARRAY_DEQUE
 #define _ARRAY_DEQUE
 
+#include "list.h"
+#include "queue.h"
+#include "segment.h"
+
 /**
  * An array based deque containing generic data. The operations that can be 
  * performed on a deque are:
@@ -18,10 +22,22 @@
  * PopLast => Removes and returns the item at the end of the deque.
  * PeekFirst => Returns the item on the front of the deque.
  * PeekLast => Returns the item at the end of the deque.
+ * Peek => Returns the item at an index in the deque.
+ * Set => Sets the item at an index in the deque.
+ * Rotate => Moves items from one end of the deque to the other.
+ * FromList => Returns a deque with the items of a List.
+ * FromQueue => Returns a deque with the items of a Queue.
  * PushFirst => Adds an item to the front of the deque.
  * PushLast => Adds an item to the end of the deque.
+ * ReadSegments => Returns the runs of items in the deque's array.
+ * CommitRead => Removes items read through the segments from the front.
+ * WriteSegments => Returns the runs of free slots after the end of the deque.
+ * CommitWrite => Adds items written through the segments to the end.
  * Resize => Doubles the capacity of the deque.
  * Traverse => Traverses the deque of items either forwards or backwards.
+ * ParallelForEach => Traverses the deque of items on several threads.
+ * ParallelMap => Maps every item into a new deque on several threads.
+ * ParallelReduce => Combines every item into one on several threads.
  * Clear => Clears all items from the deque.
  * Free => Frees the deque from memory.
  * 
@@ -95,6 +111,52 @@ void* adeque_peekLast(ArrayDeque* q);
  */
 void* adeque_peek(ArrayDeque* q, unsigned int index);
 
+/**
+ * Sets the item at the specified index in the deque, returning false if
+ * the index is out of bounds.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The deque to set the item in.
+ * @param index => The index of the item from the front of the deque.
+ * @param item => The item to set.
+ */
+int adeque_set(ArrayDeque* q, unsigned int index, void* item);
+
+/**
+ * Rotates the items of the deque by the given distance. A positive
+ * distance moves that many items from the end of the deque to the front,
+ * and a negative distance moves items from the front to the end. When the
+ * deque is full only the head and tail move.
+ * 
+ * Efficiency: O(min(k, n-k)) where 'k' is the distance, O(1) if full.
+ * 
+ * @param q => The deque to rotate.
+ * @param distance => The number of places to rotate the items.
+ */
+void adeque_rotate(ArrayDeque* q, int distance);
+
+/**
+ * Returns a new deque with the items of the list in the same order,
+ * allocated to the heap. The list is not changed. This gives code that
+ * indexes into a List O(1) access instead of walking the list.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The list to copy the items of.
+ */
+ArrayDeque* adeque_fromList(List* l);
+
+/**
+ * Returns a new deque with the items of the queue from front to back,
+ * allocated to the heap. The queue is not changed.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param queue => The queue to copy the items of.
+ */
+ArrayDeque* adeque_fromQueue(Queue* queue);
+
 /**
  * Adds an item to the front of a deque.
  * 
@@ -137,6 +199,56 @@ void adeque_pushfFirst(ArrayDeque* q, void* item);
  */
 void adeque_pushfLast(ArrayDeque* q, void* item);
 
+/**
+ * Fills in the runs of the deque's array holding its items from front to
+ * back and returns how many runs there are, which is 0 if the deque is
+ * empty and 2 if the items wrap around the end of the array. The items can
+ * then be read in place and removed with adeque_commitRead.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The deque to get the readable segments of.
+ * @param segments => The two segments to fill in.
+ */
+unsigned int adeque_readSegments(ArrayDeque* q, ArraySegment segments[2]);
+
+/**
+ * Removes count items from the front of the deque without returning them,
+ * after they were read through adeque_readSegments. Returns false and
+ * removes nothing if the deque has fewer items.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The deque to pop from.
+ * @param count => The number of items to remove.
+ */
+int adeque_commitRead(ArrayDeque* q, unsigned int count);
+
+/**
+ * Fills in the runs of the deque's array that are free, in the order
+ * items pushed onto the end of the deque would fill them, and returns how
+ * many runs there are, which is 0 if the deque is full. Items can then be
+ * written in place and added with adeque_commitWrite.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The deque to get the writable segments of.
+ * @param segments => The two segments to fill in.
+ */
+unsigned int adeque_writeSegments(ArrayDeque* q, ArraySegment segments[2]);
+
+/**
+ * Adds the count items written through adeque_writeSegments to the end of
+ * the deque. Returns false and adds nothing if the deque doesn't have that
+ * many free slots.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The deque to push onto.
+ * @param count => The number of items written.
+ */
+int adeque_commitWrite(ArrayDeque* q, unsigned int count);
+
 /**
  * Resizes an deque to a new capacity.
  * 
@@ -180,6 +292,49 @@ void adeque_traverseForward(ArrayDeque* q, void (*process)(void* item));
  */
 void adeque_traverseBackward(ArrayDeque* q, void (*process)(void* item));
 
+/**
+ * Calls the process method on every item of the deque using several
+ * threads. Threads claim chunks of PARALLEL_CHUNK items at a time so no
+ * thread sits idle while another has work left. The order items are
+ * processed in is undefined and the deque must not be modified until
+ * this returns.
+ * 
+ * Efficiency: O(n/t) where 't' is the number of threads.
+ * 
+ * @param q => The deque to traverse.
+ * @param process => The method that is called on every item.
+ * @param threads => The number of threads to use, 0 for one per processor.
+ */
+void adeque_parallelForEach(ArrayDeque* q, void (*process)(void* item), unsigned int threads);
+
+/**
+ * Returns a new deque with the same capacity holding the result of the
+ * map method on every item of the deque in the same order, using several
+ * threads.
+ * 
+ * Efficiency: O(n/t) where 't' is the number of threads.
+ * 
+ * @param q => The deque to map.
+ * @param map => The method that returns the mapped value of an item.
+ * @param threads => The number of threads to use, 0 for one per processor.
+ */
+ArrayDeque* adeque_parallelMap(ArrayDeque* q, void* (*map)(void* item), unsigned int threads);
+
+/**
+ * Combines every item of the deque from front to back into one using
+ * several threads. If deterministic is true the results of each chunk
+ * are combined in order so the result never depends on the threads. NULL
+ * is returned if the deque is empty.
+ * 
+ * Efficiency: O(n/t) where 't' is the number of threads.
+ * 
+ * @param q => The deque to reduce.
+ * @param reduce => The method that combines two items or results into one.
+ * @param threads => The number of threads to use, 0 for one per processor.
+ * @param deterministic => Whether chunks are combined in order.
+ */
+void* adeque_parallelReduce(ArrayDeque* q, void* (*reduce)(void* a, void* b), unsigned int threads, int deterministic);
+
 /**
  * Clears the deque of all items.
  * 
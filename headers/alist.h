@@ -10,16 +10,44 @@
 #ifndef _ARRAY_LIST
 #define _ARRAY_LIST
 
+#include <stddef.h>
+
+// The growth factor which doubles the capacity of a full list.
+#define ALIST_GROWTH_DOUBLE	2.0f
+// The growth factor which adds half again to the capacity of a full list.
+#define ALIST_GROWTH_HALF		1.5f
+
+// The default size in bytes at which a list's data is mapped directly
+// from the operating system so it can grow without being copied.
+#define ALIST_MAP_THRESHOLD	(1 << 26)
+
+// The number of items a list needs before a parallel sort uses threads.
+#define ALIST_PARALLEL_THRESHOLD	(1 << 16)
+
 /**
  * This is an array-list containing generic data. The operations that can be 
  * performed on an array list are:
  * 
  * Add => Add an item to the end of the list.
+ * AddAll => Add an array of items to the end of the list.
  * Insert => Insert an item into the list at some point.
+ * InsertRange => Insert an array of items into the list at some point.
  * Remove => Remove an item from the list.
  * RemoveAt => Remove an item at an index in the list.
+ * RemoveRange => Remove a range of items from the list.
+ * RemoveIf => Remove all items from the list that match a predicate.
  * Resize => Doubles the capacity of the array list.
+ * Reserve => Makes sure the list can hold some number of items.
+ * ShrinkToFit => Releases any capacity not used by the items.
  * Traverse => Traverses the list of items.
+ * ParallelForEach => Traverses the list of items on several threads.
+ * ParallelMap => Maps every item into a new list on several threads.
+ * ParallelReduce => Combines every item into one on several threads.
+ * Sort => Sorts the list by comparing items.
+ * SortByKey => Sorts the list by an integer key of each item.
+ * StableSort => Sorts the list keeping the order of equal items.
+ * ParallelSort => Sorts the list with several threads.
+ * BinarySearch => Finds an item in a sorted list.
  * Clear => Clears all items from the list.
  * Free => Frees the list from memory.
  * 
@@ -33,6 +61,13 @@ typedef struct
 	unsigned int capacity;
 	// The array of data in this list.
 	void** data;
+	// The factor the capacity is multiplied by when the list is full.
+	float growth;
+	// The size in bytes at which the data is mapped from the operating
+	// system instead of allocated, or 0 to never map the data.
+	size_t mapThreshold;
+	// Whether the data is currently mapped from the operating system.
+	int mapped;
 
 } ArrayList;
 
@@ -59,21 +94,35 @@ ArrayList* newArrayList(unsigned int initialSize);
 void* alist_get(ArrayList* l, unsigned int index);
 
 /**
- * This will add an item to the end of the list.
+ * This will add an item to the end of the list. Returns false and adds
+ * nothing if the list was full and couldn't grow.
  * 
  * Efficiency: O(1)
  * 
  * @param l => The array list to add to.
  * @param item => The generic data to add to the list.
  */
-void alist_add(ArrayList* l, void* item);
+int alist_add(ArrayList* l, void* item);
+
+/**
+ * This will add an array of items to the end of the list, growing the list
+ * at most once. Returns false and adds nothing if the list couldn't grow.
+ * 
+ * Efficiency: O(k) where 'k' is the number of items added.
+ * 
+ * @param l => The array list to add to.
+ * @param items => The array of generic data to add to the list.
+ * @param count => The number of items in the array.
+ */
+int alist_addAll(ArrayList* l, void** items, unsigned int count);
 
 /**
  * Inserts data into an array list at the given index. If the index is past
  * the end of the list then the data will not be added to the end. If the
  * index is between the beginning and end of the list then all data after
  * the given index will be shifted to make space for the item. This will return
- * true if the data was added and false if not.
+ * true if the data was added and false if not, or if the list was full and
+ * couldn't grow.
  * 
  * Efficiency: O(s-i) where 's' is the size of the list and 'i' is the index given.
  * 
@@ -83,6 +132,23 @@ void alist_add(ArrayList* l, void* item);
  */
 int alist_insert(ArrayList* l, void* item, unsigned int index);
 
+/**
+ * Inserts an array of items into an array list at the given index. The
+ * items after the index are shifted once to make space for all the items.
+ * If the index is past the end of the list or the list couldn't grow then
+ * nothing is inserted. This will return true if the items were inserted
+ * and false if not.
+ * 
+ * Efficiency: O(s-i+k) where 's' is the size of the list, 'i' is the index
+ * 	given, and 'k' is the number of items inserted.
+ * 
+ * @param l => The array list to insert into.
+ * @param items => The array of generic data to insert into the list.
+ * @param count => The number of items in the array.
+ * @param index => The index at which to place the first item.
+ */
+int alist_insertRange(ArrayList* l, void** items, unsigned int count, unsigned int index);
+
 /**
  * Removes and returns the item at the given index. If no item exists at the
  * given index or its completely outside the bounds of the list NULL is returned.
@@ -106,6 +172,31 @@ void* alist_removeAt(ArrayList* l, unsigned int index);
  */
 void* alist_remove(ArrayList* l, void* item, int (*equals)(void*, void*));
 
+/**
+ * Removes the items from the start index up to but not including the end
+ * index, shifting the items after them once. The range is cut off at the
+ * end of the list. The number of items removed is returned.
+ * 
+ * Efficiency: O(s-i) where 's' is the size of the list and 'i' is the start index.
+ * 
+ * @param l => The array list to remove from.
+ * @param start => The index of the first item to remove.
+ * @param end => The index after the last item to remove.
+ */
+unsigned int alist_removeRange(ArrayList* l, unsigned int start, unsigned int end);
+
+/**
+ * Removes every item for which the predicate returns true in a single
+ * pass, keeping the remaining items in order. The number of items 
+ * removed is returned.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The array list to remove from.
+ * @param predicate => The method that returns true for items to remove.
+ */
+unsigned int alist_removeIf(ArrayList* l, int (*predicate)(void* item));
+
 /**
  * Returns true if this list has no items.
  * 
@@ -118,14 +209,63 @@ int alist_isEmpty(ArrayList* l);
 /**
  * Resizes the given array list with a new capacity. If the new size passed
  * in is smaller then the number of items currently in the list then the
- * items at the end of the list are removed.
+ * items at the end of the list are removed. The capacity is at least 1.
+ * Returns false and leaves the list untouched if the data couldn't be
+ * reallocated.
  * 
  * Efficiency: O(1)
  * 
  * @param l => The array list to resize.
  * @param newSize => The new size of the array list.
  */
-void alist_resize(ArrayList* l, unsigned int newSize);
+int alist_resize(ArrayList* l, unsigned int newSize);
+
+/**
+ * Makes sure the list has room for at least the given number of items so
+ * they can be added without the list growing. The capacity is never
+ * made smaller by this.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The array list to reserve space in.
+ * @param capacity => The number of items the list should be able to hold.
+ */
+void alist_reserve(ArrayList* l, unsigned int capacity);
+
+/**
+ * Resizes the list so its capacity is the number of items in it, 
+ * releasing any unused space.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The array list to shrink.
+ */
+void alist_shrinkToFit(ArrayList* l);
+
+/**
+ * Sets the factor the capacity of the list is multiplied by when an item
+ * is added to a full list. A factor of 2 (the default) wastes more space
+ * but grows less often then a factor of 1.5.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The array list to set the growth of.
+ * @param factor => The growth factor which must be greater then 1.
+ */
+void alist_setGrowth(ArrayList* l, float factor);
+
+/**
+ * Sets the size in bytes at which the data of the list is mapped directly
+ * from the operating system. Once mapped the list grows by remapping its
+ * pages which avoids copying the data. This is only supported on Linux
+ * and is ignored elsewhere.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The array list to set the map threshold of.
+ * @param bytes => The size of data to start mapping at, 0 to never map.
+ */
+void alist_setMapThreshold(ArrayList* l, size_t bytes);
 
 /**
  * Traverse the list without affecting it starting at the front of the
@@ -151,6 +291,117 @@ void alist_traverseForward(ArrayList* l, void (*process)(void* item));
  */
 void alist_traverseBackward(ArrayList* l, void (*process)(void* item));
 
+/**
+ * Calls the process method on every item of the list using several
+ * threads. Threads claim chunks of PARALLEL_CHUNK items at a time so no
+ * thread sits idle while another has work left. The order items are
+ * processed in is undefined and the list must not be modified until this
+ * returns.
+ * 
+ * Efficiency: O(n/t) where 't' is the number of threads.
+ * 
+ * @param l => The array list to traverse.
+ * @param process => The method that is called on every item.
+ * @param threads => The number of threads to use, 0 for one per processor.
+ */
+void alist_parallelForEach(ArrayList* l, void (*process)(void* item), unsigned int threads);
+
+/**
+ * Returns a new list with the result of the map method on every item of
+ * the list in the same order, using several threads.
+ * 
+ * Efficiency: O(n/t) where 't' is the number of threads.
+ * 
+ * @param l => The array list to map.
+ * @param map => The method that returns the mapped value of an item.
+ * @param threads => The number of threads to use, 0 for one per processor.
+ */
+ArrayList* alist_parallelMap(ArrayList* l, void* (*map)(void* item), unsigned int threads);
+
+/**
+ * Combines every item of the list into one using several threads. Each
+ * chunk of the list is combined from front to back and the results of
+ * the chunks are combined after. If deterministic is true the chunks are
+ * combined in order so the result never depends on the threads, which
+ * matters when the reduce method isn't associative (like adding floats).
+ * NULL is returned if the list is empty.
+ * 
+ * Efficiency: O(n/t) where 't' is the number of threads.
+ * 
+ * @param l => The array list to reduce.
+ * @param reduce => The method that combines two items or results into one.
+ * @param threads => The number of threads to use, 0 for one per processor.
+ * @param deterministic => Whether chunks are combined in order.
+ */
+void* alist_parallelReduce(ArrayList* l, void* (*reduce)(void* a, void* b), unsigned int threads, int deterministic);
+
+/**
+ * Sorts the list in place with an introsort: a quicksort on the median of
+ * three items which switches to a heapsort if it recurses too deep and to
+ * an insertion sort on small ranges. The sort is not stable.
+ * 
+ * Efficiency: O(n log n)
+ * 
+ * @param l => The array list to sort.
+ * @param compare => The method that returns a negative number, zero, or a
+ * 	positive number if the first item is less then, equal to, or greater
+ * 	then the second item.
+ */
+void alist_sort(ArrayList* l, int (*compare)(void*, void*));
+
+/**
+ * Sorts the list in place by an integer key of each item. The key of each
+ * item is extracted exactly once and the items are then sorted by a radix
+ * sort on their keys without calling back into any method. The sort is
+ * stable and takes memory for a key and a pointer for each item twice.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The array list to sort.
+ * @param key => The method that returns the key of an item.
+ */
+void alist_sortByKey(ArrayList* l, int (*key)(void*));
+
+/**
+ * Sorts the list in place with a merge sort, items which are equal keep
+ * the order they had before the sort. This allocates a buffer as large as
+ * the list while sorting.
+ * 
+ * Efficiency: O(n log n)
+ * 
+ * @param l => The array list to sort.
+ * @param compare => The method that compares two items.
+ */
+void alist_stableSort(ArrayList* l, int (*compare)(void*, void*));
+
+/**
+ * Sorts the list in place using the given number of threads. The list is
+ * split into a chunk per thread which are sorted at the same time and then
+ * merged together in pairs, each merge on its own thread. If the list has
+ * fewer then ALIST_PARALLEL_THRESHOLD items or only one thread is given
+ * this is the same as alist_sort. The sort is not stable.
+ * 
+ * Efficiency: O(n log n / t + n log t) where 't' is the number of threads.
+ * 
+ * @param l => The array list to sort.
+ * @param compare => The method that compares two items.
+ * @param threads => The number of threads to sort with.
+ */
+void alist_parallelSort(ArrayList* l, int (*compare)(void*, void*), unsigned int threads);
+
+/**
+ * Searches a sorted list for an item. If an equal item is found its index
+ * is returned, otherwise -(i + 1) is returned where 'i' is the index the
+ * item would need to be inserted at to keep the list sorted.
+ * 
+ * Efficiency: O(log n)
+ * 
+ * @param l => The sorted array list to search.
+ * @param item => The item to search for.
+ * @param compare => The method the list was sorted by.
+ */
+int alist_binarySearch(ArrayList* l, void* item, int (*compare)(void*, void*));
+
 /**
  * Clears the list of all data.
  * 
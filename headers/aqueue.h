@@ -10,6 +10,8 @@
 #ifndef _ARRAY_QUEUE
 #define _ARRAY_QUEUE
 
+#include "segment.h"
+
 /**
  * An array based queue containing generic data. The operations that can be 
  * performed on an array list are:
@@ -17,6 +19,12 @@
  * Poll => Removes and returns the item at the front of the queue.
  * Peek => Returns the item at the front of the queue.
  * Offer => Adds an item to the end of the queue.
+ * OfferMany => Adds an array of items to the end of the queue.
+ * PollMany => Removes items from the front of the queue into an array.
+ * ReadSegments => Returns the runs of items in the queue's array.
+ * CommitRead => Removes items read through the segments from the front.
+ * WriteSegments => Returns the runs of free slots in the queue's array.
+ * CommitWrite => Adds items written through the segments to the end.
  * Resize => Doubles the capacity of the queue.
  * Traverse => Traverses the queue of items either forwards or backwards.
  * Clear => Clears all items from the queue.
@@ -83,6 +91,83 @@ int aqueue_offer(ArrayQueue* q, void* item);
  */
 int aqueue_offerf(ArrayQueue* q, void* item);
 
+/**
+ * Adds an array of items to the end of the queue with one update of the
+ * tail. If the queue doesn't have room for every item, or any item is
+ * NULL, then nothing is added and false is returned.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param q => The queue to enqueue to.
+ * @param items => The array of items to enqueue.
+ * @param count => The number of items in the array.
+ */
+int aqueue_offerMany(ArrayQueue* q, void** items, unsigned int count);
+
+/**
+ * Removes up to max items from the front of the queue into the buffer in
+ * order with one update of the head and clears their slots in the queue
+ * like aqueue_poll. Returns the number of items removed.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param q => The queue to dequeue from.
+ * @param buffer => The array to place the items into.
+ * @param max => The most items to remove, which must fit in the buffer.
+ */
+unsigned int aqueue_pollMany(ArrayQueue* q, void** buffer, unsigned int max);
+
+/**
+ * Fills in the runs of the queue's array holding its items from front to
+ * back and returns how many runs there are, which is 0 if the queue is
+ * empty and 2 if the items wrap around the end of the array. The items can
+ * then be read in place and removed with aqueue_commitRead.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The queue to get the readable segments of.
+ * @param segments => The two segments to fill in.
+ */
+unsigned int aqueue_readSegments(ArrayQueue* q, ArraySegment segments[2]);
+
+/**
+ * Removes count items from the front of the queue without returning them,
+ * after they were read through aqueue_readSegments. Returns false and
+ * removes nothing if the queue has fewer items. The removed slots are not
+ * cleared, so they still point to the items until they are written over.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The queue to dequeue from.
+ * @param count => The number of items to remove.
+ */
+int aqueue_commitRead(ArrayQueue* q, unsigned int count);
+
+/**
+ * Fills in the runs of the queue's array that are free, in the order
+ * items offered to the queue would fill them, and returns how many runs
+ * there are, which is 0 if the queue is full. Items can then be written in
+ * place and added with aqueue_commitWrite.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The queue to get the writable segments of.
+ * @param segments => The two segments to fill in.
+ */
+unsigned int aqueue_writeSegments(ArrayQueue* q, ArraySegment segments[2]);
+
+/**
+ * Adds the count items written through aqueue_writeSegments to the end of
+ * the queue. Returns false and adds nothing if the queue doesn't have that
+ * many free slots.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The queue to enqueue to.
+ * @param count => The number of items written.
+ */
+int aqueue_commitWrite(ArrayQueue* q, unsigned int count);
+
 /**
  * Resizes an array queue to a new capacity.
  * 
@@ -0,0 +1,157 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _BLOCKING_QUEUE
+#define _BLOCKING_QUEUE
+
+#include <pthread.h>
+
+/**
+ * A bounded array based queue containing generic data which threads can
+ * hand items off through. Offer waits while the queue is full, so fast
+ * producers are held back to the pace of their consumers, and Poll waits
+ * while the queue is empty. A consumer can take every waiting item at once
+ * with DrainTo, so it wakes once for a batch instead of once per item.
+ * Threads are only signalled when another thread is waiting. The
+ * operations that can be performed on a blocking queue are:
+ * 
+ * Offer => Adds an item to the end of the queue, waiting while it's full.
+ * OfferTimeout => Adds an item to the end of the queue, waiting a limited time while it's full.
+ * Poll => Removes and returns the item at the front of the queue, waiting while it's empty.
+ * PollTimeout => Removes and returns the item at the front of the queue, waiting a limited time while it's empty.
+ * DrainTo => Removes many items from the front of the queue into a buffer.
+ * Size => Returns the number of items in the queue.
+ * Free => Frees the queue from memory.
+ * 
+ * Items must not be NULL since NULL is returned when no item was polled.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The lock guarding every other field.
+	pthread_mutex_t lock;
+	// Signalled when an item is added to the queue.
+	pthread_cond_t notEmpty;
+	// Signalled when items are removed from the queue.
+	pthread_cond_t notFull;
+	// The number of threads waiting for an item.
+	unsigned int pollWaiters;
+	// The number of threads waiting for a free slot.
+	unsigned int offerWaiters;
+
+	// The ring of items in the queue.
+	void** data;
+	// The maximum number of items that can be in the queue.
+	unsigned int capacity;
+	// The number of items in the queue.
+	unsigned int size;
+	// The index of the head of the queue.
+	unsigned int head;
+	// The index of the tail of the queue.
+	unsigned int tail;
+
+} BlockingQueue;
+
+/**
+ * Returns an empty blocking queue allocated to the heap.
+ * 
+ * @param capacity => The maximum number of items in the queue.
+ */
+BlockingQueue* newBlockingQueue(unsigned int capacity);
+
+/**
+ * Adds an item to the end of the queue, waiting as long as it takes for
+ * the queue to have room.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The blocking queue to enqueue to.
+ * @param item => The item to enqueue, which must not be NULL.
+ */
+void bqueue_offer(BlockingQueue* q, void* item);
+
+/**
+ * Adds an item to the end of the queue, waiting at most the given time for
+ * the queue to have room. Returns false if the queue was still full.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The blocking queue to enqueue to.
+ * @param item => The item to enqueue, which must not be NULL.
+ * @param millis => The most milliseconds to wait, 0 never waits.
+ */
+int bqueue_offerTimeout(BlockingQueue* q, void* item, unsigned int millis);
+
+/**
+ * Removes and returns the item at the front of the queue, waiting as long
+ * as it takes for an item to be offered.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The blocking queue to dequeue from.
+ */
+void* bqueue_poll(BlockingQueue* q);
+
+/**
+ * Removes and returns the item at the front of the queue, waiting at most
+ * the given time for an item to be offered. Returns NULL if the queue was
+ * still empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The blocking queue to dequeue from.
+ * @param millis => The most milliseconds to wait, 0 never waits.
+ */
+void* bqueue_pollTimeout(BlockingQueue* q, unsigned int millis);
+
+/**
+ * Waits until the queue has an item and then removes as many items as are
+ * in the queue, up to max, from the front of the queue into the buffer in
+ * the order they were offered. Returns the number of items removed.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param q => The blocking queue to dequeue from.
+ * @param buffer => The array to place the items into.
+ * @param max => The most items to remove, which must fit in the buffer.
+ */
+unsigned int bqueue_drainTo(BlockingQueue* q, void** buffer, unsigned int max);
+
+/**
+ * Returns the number of items in the queue. When called while other
+ * threads are using the queue this is only a snapshot.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The blocking queue to get the size of.
+ */
+unsigned int bqueue_size(BlockingQueue* q);
+
+/**
+ * Returns true if the queue has no items. When called while other threads
+ * are using the queue this is only a snapshot.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The blocking queue to check for emptiness.
+ */
+int bqueue_isEmpty(BlockingQueue* q);
+
+/**
+ * Removes the queue completely from memory. No threads may be using the
+ * queue.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The blocking queue to free from memory.
+ */
+void bqueue_free(BlockingQueue* q);
+
+#endif /* _BLOCKING_QUEUE */
\ No newline at end of file
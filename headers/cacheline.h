@@ -0,0 +1,17 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _CACHE_LINE
+#define _CACHE_LINE
+
+// The size in bytes of a cache line, used to keep data written by
+// different threads from sharing a line.
+#define CACHE_LINE	64
+
+#endif /* _CACHE_LINE */
\ No newline at end of file
@@ -0,0 +1,207 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _CHUNK_LIST
+#define _CHUNK_LIST
+
+// The maximum number of items in a leaf chunk of a chunk list.
+#define CLIST_LEAF	64
+// The maximum number of children of a branch of a chunk list.
+#define CLIST_BRANCH	32
+
+/**
+ * This is a leaf chunk of a chunk list which holds a run of items.
+ */
+typedef struct
+{
+	// The number of items in this chunk.
+	unsigned int count;
+	// The items in this chunk.
+	void* items[CLIST_LEAF];
+
+} ChunkListLeaf;
+
+/**
+ * This is a branch of a chunk list which holds its children along with
+ * the number of items under each of them.
+ */
+typedef struct
+{
+	// The number of children of this branch.
+	unsigned int count;
+	// The number of items under each child.
+	unsigned int sizes[CLIST_BRANCH];
+	// The children of this branch, leaves if the branch is just above the
+	// leaves and branches otherwise.
+	void* children[CLIST_BRANCH];
+
+} ChunkListBranch;
+
+/**
+ * This is a chunk list containing generic data. The items are stored in
+ * small chunks which are the leaves of a B+tree where every branch knows
+ * how many items are under each of its children, so an item can be found
+ * by its index by walking down the tree. There is never one huge array to
+ * grow or copy, and inserting or removing only shifts the items in one
+ * chunk. Items added to the end go into a tail chunk outside of the tree
+ * which is put into the tree once it's full. The operations that can be
+ * performed on a chunk list are:
+ * 
+ * Get => Returns the item at an index in the list.
+ * Set => Sets the item at an index in the list.
+ * Add => Add an item to the end of the list.
+ * Insert => Insert an item into the list at some point.
+ * Remove => Remove an item from the list.
+ * RemoveAt => Remove an item at an index in the list.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Free => Frees the list from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of elements in this list.
+	unsigned int size;
+	// The number of levels of branches above the leaves of the tree.
+	unsigned int height;
+	// The root of the tree, a leaf if the height is 0 or NULL if empty.
+	void* root;
+	// The chunk of items at the end of the list not yet in the tree.
+	ChunkListLeaf* tail;
+
+} ChunkList;
+
+/**
+ * Returns a new chunk list with no items, allocated to the heap.
+ */
+ChunkList* newChunkList();
+
+/**
+ * Returns the i'th item in the chunk list.
+ * 
+ * Efficiency: O(log n)
+ * 
+ * @param l => The chunk list to get from.
+ * @param index => The index of the data to get in the list.
+ */
+void* clist_get(ChunkList* l, unsigned int index);
+
+/**
+ * Sets the i'th item in the chunk list, returning false if the index is
+ * out of bounds.
+ * 
+ * Efficiency: O(log n)
+ * 
+ * @param l => The chunk list to set in.
+ * @param index => The index of the data to set in the list.
+ * @param item => The generic data to put in the list.
+ */
+int clist_set(ChunkList* l, unsigned int index, void* item);
+
+/**
+ * This will add an item to the end of the list.
+ * 
+ * Efficiency: O(1) amortized
+ * 
+ * @param l => The chunk list to add to.
+ * @param item => The generic data to add to the list.
+ */
+void clist_add(ChunkList* l, void* item);
+
+/**
+ * Inserts data into a chunk list at the given index. If the index is past
+ * the end of the list then the data is not added. This will return true
+ * if the data was added and false if not.
+ * 
+ * Efficiency: O(log n)
+ * 
+ * @param l => The chunk list to insert into.
+ * @param item => The generic data to insert into the list.
+ * @param index => The index at which to place the data.
+ */
+int clist_insert(ChunkList* l, void* item, unsigned int index);
+
+/**
+ * Removes the first item from the list that equals the given item based
+ * on the equals method and returns it. If no item was equal then NULL is
+ * returned.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The chunk list to remove from.
+ * @param item => The item to remove from the list.
+ * @param equals => The method that returns true if two items are equal.
+ */
+void* clist_remove(ChunkList* l, void* item, int (*equals)(void*, void*));
+
+/**
+ * Removes and returns the item at the given index. If no item exists at
+ * the given index then NULL is returned. Chunks left too empty are merged
+ * with their neighbors.
+ * 
+ * Efficiency: O(log n)
+ * 
+ * @param l => The chunk list to remove from.
+ * @param index => The index of the item to remove.
+ */
+void* clist_removeAt(ChunkList* l, unsigned int index);
+
+/**
+ * Returns true if the chunk list has no items in it.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The chunk list to check for emptiness.
+ */
+int clist_isEmpty(ChunkList* l);
+
+/**
+ * Traverse the list without affecting it starting at the front of the
+ * list and moving towards the back. Each item traversed will be sent
+ * through the process method.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The chunk list to traverse from front-to-back.
+ * @param process => The method that is called every time an item is traversed.
+ */
+void clist_traverseForward(ChunkList* l, void (*process)(void* item));
+
+/**
+ * Traverse the list without affecting it starting at the back of the
+ * list and moving towards the front. Each item traversed will be sent
+ * through the process method.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The chunk list to traverse from back-to-front.
+ * @param process => The method that is called every time an item is traversed.
+ */
+void clist_traverseBackward(ChunkList* l, void (*process)(void* item));
+
+/**
+ * Clears the list of all data, freeing every chunk but the tail.
+ * 
+ * Efficiency: O(n/c) where 'c' is the number of items in a chunk.
+ * 
+ * @param l => The chunk list to clear of all data.
+ */
+void clist_clear(ChunkList* l);
+
+/**
+ * Removes the list completely from memory.
+ * 
+ * Efficiency: O(n/c) where 'c' is the number of items in a chunk.
+ * 
+ * @param l => The chunk list to clear and free from memory.
+ */
+void clist_free(ChunkList* l);
+
+#endif /* _CHUNK_LIST */
\ No newline at end of file
@@ -0,0 +1,220 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _DISRUPTOR
+#define _DISRUPTOR
+
+#include <stdatomic.h>
+
+#include "cacheline.h"
+
+/**
+ * A consumer of a disruptor. Every consumer reads every event, and keeps
+ * its own cursor of how far it has read. A consumer can depend on other
+ * consumers, in which case it only reads an event once they're done with
+ * it, so consumers can be chained into stages that share the events.
+ */
+typedef struct DisruptorConsumer
+{
+	// The sequence of the next event this consumer reads.
+	_Alignas(CACHE_LINE) atomic_ullong sequence;
+	// The sequence after the last event known to be readable.
+	unsigned long long available;
+	// The disruptor this consumer reads from.
+	struct Disruptor* disruptor;
+	// The consumers that must be done with an event before this one reads it.
+	struct DisruptorConsumer** dependencies;
+	// The number of dependencies.
+	unsigned int dependencyCount;
+
+} DisruptorConsumer;
+
+/**
+ * A ring of preallocated events which one producer writes and any number
+ * of consumers read, so every consumer sees every event without it being
+ * copied for each one. The producer claims a batch of slots, writes the
+ * events in place, and publishes the batch with one store, waiting only
+ * when the slowest consumer is a full ring behind. Consumers wait for a
+ * batch, read it in place, and release it with one store. Waiting spins
+ * briefly and then yields the processor. The operations that can be
+ * performed on a disruptor are:
+ * 
+ * AddConsumer => Adds a consumer, optionally behind other consumers.
+ * Claim => Reserves slots for the producer to write events into.
+ * Get => Returns the slot of an event by its sequence.
+ * Publish => Makes the claimed events readable by consumers.
+ * WaitFor => Waits until a consumer has events to read.
+ * Available => Returns the number of events a consumer can read.
+ * Release => Marks events as read by a consumer.
+ * Consume => Reads and releases every event available to a consumer.
+ * Free => Frees the disruptor and its consumers from memory.
+ * 
+ * Example:
+ * 	unsigned long long s = disruptor_claim(d, 1);
+ * 	Event* e = disruptor_get(d, s);
+ * 	e->value = 42;
+ * 	disruptor_publish(d, 1);
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct Disruptor
+{
+	// The sequence after the last published event.
+	_Alignas(CACHE_LINE) atomic_ullong published;
+
+	// The sequence after the last claimed event, only used by the producer.
+	_Alignas(CACHE_LINE) unsigned long long claimed;
+	// The lowest consumer sequence last seen by the producer.
+	unsigned long long gate;
+
+	// The number of event slots, a power of 2.
+	_Alignas(CACHE_LINE) unsigned int capacity;
+	// The capacity minus one, used to wrap sequences into the ring.
+	unsigned int mask;
+	// The size of an event in bytes.
+	unsigned int eventSize;
+	// The preallocated event slots.
+	char* slots;
+	// The consumers of the disruptor.
+	DisruptorConsumer** consumers;
+	// The number of consumers.
+	unsigned int consumerCount;
+
+} Disruptor;
+
+/**
+ * Returns a disruptor with no consumers allocated to the heap, with every
+ * event slot zeroed.
+ * 
+ * @param capacity => The number of event slots, rounded up to a power of 2.
+ * @param eventSize => The size of an event in bytes.
+ */
+Disruptor* newDisruptor(unsigned int capacity, unsigned int eventSize);
+
+/**
+ * Adds a consumer which reads every event published after it's added.
+ * Consumers must be added before the producer starts publishing. Returns
+ * the consumer, which is freed along with the disruptor.
+ * 
+ * @param d => The disruptor to add a consumer to.
+ * @param dependencies => The consumers that must read an event before this
+ * 	one can, or NULL.
+ * @param dependencyCount => The number of dependencies.
+ */
+DisruptorConsumer* disruptor_addConsumer(Disruptor* d, DisruptorConsumer** dependencies, unsigned int dependencyCount);
+
+/**
+ * Reserves the next count slots for the producer, waiting until every
+ * consumer has read the events in them. Returns the sequence of the first
+ * slot. Only the producer may call this.
+ * 
+ * Efficiency: O(1), O(c) when the consumers are checked.
+ * 
+ * @param d => The disruptor to claim slots of.
+ * @param count => The number of slots, at most the capacity.
+ */
+unsigned long long disruptor_claim(Disruptor* d, unsigned int count);
+
+/**
+ * Reserves the next count slots for the producer if every consumer has
+ * read the events in them, without waiting. Returns false and claims
+ * nothing if they haven't, otherwise sets the sequence of the first slot.
+ * Only the producer may call this.
+ * 
+ * Efficiency: O(1), O(c) when the consumers are checked.
+ * 
+ * @param d => The disruptor to claim slots of.
+ * @param count => The number of slots, at most the capacity.
+ * @param sequence => Set to the sequence of the first slot.
+ */
+int disruptor_tryClaim(Disruptor* d, unsigned int count, unsigned long long* sequence);
+
+/**
+ * Returns the slot of the event with the given sequence. The producer may
+ * write to slots it has claimed and consumers may read from slots they
+ * have waited for.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param d => The disruptor with the slot.
+ * @param sequence => The sequence of the event.
+ */
+void* disruptor_get(Disruptor* d, unsigned long long sequence);
+
+/**
+ * Makes the next count claimed events readable by the consumers. Batches
+ * are published in the order they were claimed. Only the producer may call
+ * this.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param d => The disruptor to publish events to.
+ * @param count => The number of claimed events to publish.
+ */
+void disruptor_publish(Disruptor* d, unsigned int count);
+
+/**
+ * Waits until the consumer has events to read and returns how many it
+ * can read starting at its sequence. Only the consumer's thread may call
+ * this.
+ * 
+ * Efficiency: O(d) where 'd' is the number of dependencies.
+ * 
+ * @param c => The consumer to wait for events for.
+ */
+unsigned int disruptor_waitFor(DisruptorConsumer* c);
+
+/**
+ * Returns how many events the consumer can read starting at its sequence
+ * without waiting, which may be 0. Only the consumer's thread may call
+ * this.
+ * 
+ * Efficiency: O(d) where 'd' is the number of dependencies.
+ * 
+ * @param c => The consumer to check for events.
+ */
+unsigned int disruptor_available(DisruptorConsumer* c);
+
+/**
+ * Marks the next count events as read by the consumer, letting consumers
+ * that depend on it read them and the producer reuse their slots once every
+ * consumer is done. Only the consumer's thread may call this.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param c => The consumer that read the events.
+ * @param count => The number of events read, at most the number available.
+ */
+void disruptor_release(DisruptorConsumer* c, unsigned int count);
+
+/**
+ * Waits until the consumer has events to read, calls the handler on every
+ * one in order, and then releases them all at once. Returns the number of
+ * events handled. Only the consumer's thread may call this.
+ * 
+ * Efficiency: O(n) where 'n' is the number of events available.
+ * 
+ * @param c => The consumer to read events for.
+ * @param handler => The method called with every event and its sequence.
+ * @param arg => The argument passed to every call of the handler.
+ */
+unsigned int disruptor_consume(DisruptorConsumer* c,
+	void (*handler)(void* event, unsigned long long sequence, void* arg), void* arg);
+
+/**
+ * Removes the disruptor and its consumers completely from memory. No
+ * threads may be using the disruptor.
+ * 
+ * Efficiency: O(c)
+ * 
+ * @param d => The disruptor to free from memory.
+ */
+void disruptor_free(Disruptor* d);
+
+#endif /* _DISRUPTOR */
\ No newline at end of file
@@ -0,0 +1,190 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _GAP_LIST
+#define _GAP_LIST
+
+/**
+ * This is a gap-buffer list containing generic data. The array of items
+ * has an empty gap in it which sits where the last insert or remove took
+ * place. Inserting or removing at the gap only moves the edge of the gap,
+ * and moving the gap only shifts the items between its old and new spot,
+ * so edits that stay near each other (like typing at a cursor) are O(1)
+ * while getting an item by its index is still O(1). The operations that
+ * can be performed on a gap list are the same as on an array list:
+ * 
+ * Get => Returns the item at an index in the list.
+ * Set => Sets the item at an index in the list.
+ * Add => Add an item to the end of the list.
+ * Insert => Insert an item into the list at some point.
+ * Remove => Remove an item from the list.
+ * RemoveAt => Remove an item at an index in the list.
+ * Resize => Changes the capacity of the gap list.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Free => Frees the list from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of elements in this list.
+	unsigned int size;
+	// The maximum number of items that can be in the list.
+	unsigned int capacity;
+	// The index in the array of the first empty slot of the gap.
+	unsigned int gapStart;
+	// The index in the array of the first item after the gap.
+	unsigned int gapEnd;
+	// The array of data in this list with the gap somewhere in it.
+	void** data;
+
+} GapList;
+
+/**
+ * Returns a new gap list with no items, allocated to the heap.
+ * 
+ * @param initialSize => The starting length of the array of data.
+ */
+GapList* newGapList(unsigned int initialSize);
+
+/**
+ * Returns the i'th item in the gap list.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The gap list to get from.
+ * @param index => The index of the data to get in the list.
+ */
+void* glist_get(GapList* l, unsigned int index);
+
+/**
+ * Sets the i'th item in the gap list, returning false if the index is
+ * out of bounds.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The gap list to set in.
+ * @param index => The index of the data to set in the list.
+ * @param item => The generic data to put in the list.
+ */
+int glist_set(GapList* l, unsigned int index, void* item);
+
+/**
+ * This will add an item to the end of the list. This moves the gap to the
+ * end of the list.
+ * 
+ * Efficiency: O(1) if the last edit was at the end of the list.
+ * 
+ * @param l => The gap list to add to.
+ * @param item => The generic data to add to the list.
+ */
+void glist_add(GapList* l, void* item);
+
+/**
+ * Inserts data into a gap list at the given index, moving the gap there
+ * first. If the index is past the end of the list the data is not added.
+ * This will return true if the data was added and false if not.
+ * 
+ * Efficiency: O(d) where 'd' is the distance from the last edit, O(1)
+ * 	amortized for inserts near each other.
+ * 
+ * @param l => The gap list to insert into.
+ * @param item => The generic data to insert into the list.
+ * @param index => The index at which to place the data.
+ */
+int glist_insert(GapList* l, void* item, unsigned int index);
+
+/**
+ * Removes the first item from the list that equals the given item based
+ * on the equals method and returns it. If no item was equal then NULL is
+ * returned.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The gap list to remove from.
+ * @param item => The item to remove from the list.
+ * @param equals => The method that returns true if two items are equal.
+ */
+void* glist_remove(GapList* l, void* item, int (*equals)(void*, void*));
+
+/**
+ * Removes and returns the item at the given index, moving the gap there
+ * first. If no item exists at the given index then NULL is returned.
+ * 
+ * Efficiency: O(d) where 'd' is the distance from the last edit.
+ * 
+ * @param l => The gap list to remove from.
+ * @param index => The index of the item to remove.
+ */
+void* glist_removeAt(GapList* l, unsigned int index);
+
+/**
+ * Returns true if the gap list has no items in it.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The gap list to check for emptiness.
+ */
+int glist_isEmpty(GapList* l);
+
+/**
+ * Resizes the capacity of the gap list. If the new capacity is smaller
+ * then the number of items then the items at the end are removed.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The gap list to resize.
+ * @param newSize => The new capacity of the list.
+ */
+void glist_resize(GapList* l, unsigned int newSize);
+
+/**
+ * Traverse the list without affecting it starting at the front of the
+ * list and moving towards the back. Each item traversed will be sent
+ * through the process method.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The gap list to traverse from front-to-back.
+ * @param process => The method that is called every time an item is traversed.
+ */
+void glist_traverseForward(GapList* l, void (*process)(void* item));
+
+/**
+ * Traverse the list without affecting it starting at the back of the
+ * list and moving towards the front. Each item traversed will be sent
+ * through the process method.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The gap list to traverse from back-to-front.
+ * @param process => The method that is called every time an item is traversed.
+ */
+void glist_traverseBackward(GapList* l, void (*process)(void* item));
+
+/**
+ * Clears the list of all data.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The gap list to clear of all data.
+ */
+void glist_clear(GapList* l);
+
+/**
+ * Removes the list completely from memory.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The gap list to clear and free from memory.
+ */
+void glist_free(GapList* l);
+
+#endif /* _GAP_LIST */
\ No newline at end of file
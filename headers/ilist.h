@@ -0,0 +1,337 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _INTRUSIVE_LIST
+#define _INTRUSIVE_LIST
+
+#include <stddef.h>
+
+/**
+ * Returns the structure an ILink is embedded in given a pointer to the
+ * link, the type of the structure, and the name of the link in it.
+ *
+ * Example:
+ * 	typedef struct { int id; ILink link; } Job;
+ * 	Job* job = ilist_entry(ilist_first(l), Job, link);
+ */
+#define ilist_entry(link, type, member) \
+	((type*)((char*)(link) - offsetof(type, member)))
+
+/**
+ * This is a link which is embedded in the structure of an item so the
+ * item can be placed in an intrusive list without allocating a node. An
+ * item can be in as many lists at once as it has links.
+ */
+typedef struct ILink
+{
+	// The previous link in the list
+	struct ILink* previous;
+	// The next link in the list
+	struct ILink* next;
+
+} ILink;
+
+/**
+ * This is an intrusive doubly linked-list. Instead of the list holding a
+ * node for every item, every item holds the link for the list, so adding
+ * and removing never allocates and an item can be removed from wherever
+ * it is in the list in constant time. The list owns none of its items.
+ * The list is circular through a link it holds itself, so it must not be
+ * copied with memcpy or assignment. The operations that can be performed
+ * on an intrusive list are:
+ * 
+ * Init => Starts a list declared on the stack or in another structure.
+ * Add => Add an item to the end of the list.
+ * AddFirst => Adds an item to the beginning of the list.
+ * InsertBefore => Inserts an item before an item in the list.
+ * InsertAfter => Inserts an item after an item in the list.
+ * Remove => Removes an item from anywhere in the list.
+ * RemoveFirst => Removes and returns the first item in the list.
+ * RemoveLast => Removes and returns the last item in the list.
+ * First/Last => Returns the item at either end of the list.
+ * Next/Previous => Returns the item next to an item in the list.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Free => Frees the list from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of items in this list.
+	unsigned int size;
+	// The link before the first item and after the last item.
+	ILink head;
+
+} IList;
+
+/**
+ * An intrusive queue is an intrusive list where items are offered to the
+ * back and polled from the front.
+ */
+typedef IList IQueue;
+
+/**
+ * An intrusive stack is an intrusive list where items are pushed onto and
+ * popped off of the front.
+ */
+typedef IList IStack;
+
+/**
+ * Returns a new intrusive list with no items, allocated to the heap.
+ */
+IList* newIList();
+
+/**
+ * Starts an intrusive list that has been declared on the stack or inside
+ * another structure so it has no items.
+ * 
+ * @param l => The intrusive list to start.
+ */
+void ilist_init(IList* l);
+
+/**
+ * Starts a link so it's known to not be in any list.
+ * 
+ * @param link => The link to start.
+ */
+void ilink_init(ILink* link);
+
+/**
+ * Returns true if the link is in a list. This is only known for links
+ * that were started with ilink_init or have been removed from a list.
+ * 
+ * @param link => The link to check.
+ */
+int ilink_isLinked(ILink* link);
+
+/**
+ * Adds an item to the end of the list.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list to add to.
+ * @param link => The link of the item to add.
+ */
+void ilist_add(IList* l, ILink* link);
+
+/**
+ * Adds an item to the beginning of the list.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list to add to.
+ * @param link => The link of the item to add.
+ */
+void ilist_addFirst(IList* l, ILink* link);
+
+/**
+ * Inserts an item before an item already in the list.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list to insert into.
+ * @param link => The link of the item to insert.
+ * @param at => The link of the item to insert before.
+ */
+void ilist_insertBefore(IList* l, ILink* link, ILink* at);
+
+/**
+ * Inserts an item after an item already in the list.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list to insert into.
+ * @param link => The link of the item to insert.
+ * @param at => The link of the item to insert after.
+ */
+void ilist_insertAfter(IList* l, ILink* link, ILink* at);
+
+/**
+ * Removes an item from wherever it is in the list. The link is left not
+ * linked so it can be added to a list again.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list to remove from.
+ * @param link => The link of the item to remove.
+ */
+void ilist_remove(IList* l, ILink* link);
+
+/**
+ * Removes and returns the link of the first item in the list, or NULL if
+ * the list is empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list to remove from.
+ */
+ILink* ilist_removeFirst(IList* l);
+
+/**
+ * Removes and returns the link of the last item in the list, or NULL if
+ * the list is empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list to remove from.
+ */
+ILink* ilist_removeLast(IList* l);
+
+/**
+ * Returns the link of the first item in the list, or NULL if it's empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list to peek at.
+ */
+ILink* ilist_first(IList* l);
+
+/**
+ * Returns the link of the last item in the list, or NULL if it's empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list to peek at.
+ */
+ILink* ilist_last(IList* l);
+
+/**
+ * Returns the link of the item after the given item in the list, or NULL
+ * if the given item is the last one.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list being walked.
+ * @param link => The link of an item in the list.
+ */
+ILink* ilist_next(IList* l, ILink* link);
+
+/**
+ * Returns the link of the item before the given item in the list, or NULL
+ * if the given item is the first one.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list being walked.
+ * @param link => The link of an item in the list.
+ */
+ILink* ilist_previous(IList* l, ILink* link);
+
+/**
+ * Returns true if the intrusive list has no items.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The intrusive list to check for emptiness.
+ */
+int ilist_isEmpty(IList* l);
+
+/**
+ * Traverse the list from front to back sending the link of each item
+ * through the process method. The process method may remove the link it
+ * was given from the list.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The intrusive list to traverse.
+ * @param process => The method that is called every time an item is traversed.
+ */
+void ilist_traverse(IList* l, void (*process)(ILink* link));
+
+/**
+ * Clears the list of all items, leaving every link not linked.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The intrusive list to clear of all items.
+ */
+void ilist_clear(IList* l);
+
+/**
+ * Clears the list and frees the list from memory. The items are owned by
+ * the caller and are not freed.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The intrusive list to clear and free from memory.
+ */
+void ilist_free(IList* l);
+
+/**
+ * Returns a new intrusive queue with no items, allocated to the heap.
+ */
+IQueue* newIQueue();
+
+/**
+ * Adds an item to the back of the queue.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The intrusive queue to offer to.
+ * @param link => The link of the item to add.
+ */
+void iqueue_offer(IQueue* q, ILink* link);
+
+/**
+ * Removes and returns the link of the item at the front of the queue, or
+ * NULL if the queue is empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The intrusive queue to poll from.
+ */
+ILink* iqueue_poll(IQueue* q);
+
+/**
+ * Returns the link of the item at the front of the queue without removing
+ * it, or NULL if the queue is empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The intrusive queue to peek at.
+ */
+ILink* iqueue_peek(IQueue* q);
+
+/**
+ * Returns a new intrusive stack with no items, allocated to the heap.
+ */
+IStack* newIStack();
+
+/**
+ * Pushes an item onto the top of the stack.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param s => The intrusive stack to push onto.
+ * @param link => The link of the item to push.
+ */
+void istack_push(IStack* s, ILink* link);
+
+/**
+ * Removes and returns the link of the item on top of the stack, or NULL
+ * if the stack is empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param s => The intrusive stack to pop from.
+ */
+ILink* istack_pop(IStack* s);
+
+/**
+ * Returns the link of the item on top of the stack without removing it,
+ * or NULL if the stack is empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param s => The intrusive stack to peek at.
+ */
+ILink* istack_peek(IStack* s);
+
+#endif /* _INTRUSIVE_LIST */
\ No newline at end of file
@@ -0,0 +1,144 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _LEFTIST_HEAP
+#define _LEFTIST_HEAP
+
+/**
+ * This is a node for a leftist heap that holds generic data. The rank of
+ * a node is the length of the path down its right-most children.
+ */
+typedef struct LeftistHeapNode
+{
+	// The data contained in this node
+	void* data;
+	// The key used to sort this node
+	int key;
+	// The length of the right-most path from this node
+	unsigned int rank;
+
+	// The left subtree of this node, which has the higher rank
+	struct LeftistHeapNode* left;
+	// The right subtree of this node, which has the lower rank
+	struct LeftistHeapNode* right;
+
+} LeftistHeapNode;
+
+/**
+ * This is a leftist heap containing generic data which is ordered by some
+ * key value. Every node's right subtree is no taller down its right side
+ * then its left subtree, so two heaps can be melded by walking only down
+ * their right sides. The operations that can be performed on a leftist
+ * heap are:
+ *
+ * Add => Add an item to the leftist heap given a key.
+ * PeekMin => Returns the item that has the lowest key.
+ * PopMin => Removes and returns the item that has the lowest key.
+ * Meld => Moves all items from one leftist heap into another.
+ * Clear => Clears all items from the heap.
+ * Free => Frees the heap from memory.
+ *
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of items in this heap.
+	unsigned int size;
+	// The node with the lowest key in this heap.
+	LeftistHeapNode* root;
+
+} LeftistHeap;
+
+/**
+ * Creates a pool of LeftistHeapNodes.
+ *
+ * @param capacity => The maximum number of nodes that can be pooled.
+ */
+void pool_leftistheap(unsigned int capacity);
+
+/**
+ * Destroys the pool of LeftistHeapNodes.
+ */
+void unpool_leftistheap();
+
+/**
+ * Returns a new leftist heap with no items.
+ */
+LeftistHeap* newLeftistHeap();
+
+/**
+ * Adds to the leftist heap. This always succeeds and returns true.
+ *
+ * Efficiency: O(log n)
+ *
+ * @param h => The leftist heap to add to.
+ * @param key => The value or key of the item to add.
+ * @param item => The generic data to add to the heap.
+ */
+int leftistheap_add(LeftistHeap* h, int key, void* item);
+
+/**
+ * Removes the item with the minimum key from the top of the heap and
+ * melds its two subtrees to form the new heap.
+ *
+ * Efficiency: O(log n)
+ *
+ * @param h => The leftist heap to pop from.
+ */
+void* leftistheap_popMin(LeftistHeap* h);
+
+/**
+ * Returns the item at the top of the leftist heap without removing it.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The leftist heap to peek from.
+ */
+void* leftistheap_peekMin(LeftistHeap* h);
+
+/**
+ * Moves all items from the other heap into the given heap, leaving the
+ * other heap empty.
+ *
+ * Efficiency: O(log n + log m) where m is the size of the other heap.
+ *
+ * @param h => The leftist heap to meld into.
+ * @param other => The leftist heap to take all items from.
+ */
+void leftistheap_meld(LeftistHeap* h, LeftistHeap* other);
+
+/**
+ * Returns true if the leftist heap has no items in it.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The leftist heap to check for emptiness.
+ */
+int leftistheap_isEmpty(LeftistHeap* h);
+
+/**
+ * Clears the leftist heap of all items.
+ *
+ * Efficiency: O(n)
+ *
+ * @param h => The leftist heap to clear of all items.
+ */
+void leftistheap_clear(LeftistHeap* h);
+
+/**
+ * Clears the leftist heap of all items and frees the nodes and the heap
+ * from memory.
+ *
+ * Efficiency: O(n)
+ *
+ * @param h => The leftist heap to clear and free from memory.
+ */
+void leftistheap_free(LeftistHeap* h);
+
+#endif /* _LEFTIST_HEAP */
\ No newline at end of file
@@ -27,11 +27,16 @@ typedef struct
  * value. The operations that can be performed on an array list are:
  * 
  * Add => Add an item to the min heap given a key.
+ * Offer => Adds an item to a full heap only if it beats the lowest key.
  * PeekMax => Returns the item that has the lowest key.
  * PopMax => Removes and returns the item that has the lowest key.
+ * ReplaceMin => Replaces the item that has the lowest key with another.
  * Set => Sets an item with some key.
  * Update => Updates some key with a new key.
  * Exists => Returns true if a given key exists in the tree.
+ * Sort => Sorts the items in the heap by their key.
+ * Merge => Moves all items from one heap into another.
+ * DrainSorted => Removes all items from several heaps in order of key.
  * Traverse => Traverses the list of items using a Breadth-First-Search.
  * Display => Displays the heap structure given a toString method.
  * Clear => Clears all items from the list.
@@ -95,6 +100,22 @@ int minheap_add(MinHeap* h, int key, void* item);
  */
 void minheap_addf(MinHeap* h, int key, void* item);
 
+/**
+ * Offers an item to a heap which keeps the items with the highest keys
+ * seen so far, such as the top K scores in a stream. If the heap has
+ * space the item is added. If the heap is full and the key is not higher
+ * then the lowest key in the heap the item is rejected with a single
+ * comparison and false is returned, otherwise the item with the lowest
+ * key is replaced by this item.
+ * 
+ * Efficiency: O(1) when rejected, O(h) where h is the height of the heap.
+ * 
+ * @param h => The min heap to offer to.
+ * @param key => The value or key of the item to offer.
+ * @param item => The generic data to offer to the heap.
+ */
+int minheap_offer(MinHeap* h, int key, void* item);
+
 /**
  * Gets the item with the specified key and returns it. If the key isn't
  * found then NULL is returned.
@@ -116,6 +137,20 @@ void* minheap_get(MinHeap* h, int key);
  */
 void* minheap_popMin(MinHeap* h);
 
+/**
+ * Replaces the item with the minimum key with the given item and heapifies
+ * down once, which is faster then a pop followed by an add. The item that
+ * was replaced is returned. If the heap is empty the item is added and
+ * NULL is returned.
+ * 
+ * Efficiency: O(h) where h is the height of the heap.
+ * 
+ * @param h => The min heap to replace the minimum of.
+ * @param key => The value or key of the new item.
+ * @param item => The generic data to put in the heap.
+ */
+void* minheap_replaceMin(MinHeap* h, int key, void* item);
+
 /**
  * Returns the item at the top of the min heap without removing it.
  * 
@@ -177,6 +212,47 @@ int minheap_getHeight(MinHeap* h);
  */
 void minheap_resize(MinHeap* h, unsigned int capacity);
 
+/**
+ * Sorts the nodes of the heap in place so they're in ascending order of
+ * their keys without allocating any memory. A sorted array is still a
+ * valid min heap so the heap can continue to be used afterwards. The
+ * item with the highest key is at h->nodes[h->size - 1].
+ * 
+ * Efficiency: O(n log n)
+ * 
+ * @param h => The min heap to sort.
+ */
+void minheap_sort(MinHeap* h);
+
+/**
+ * Moves all items from the other heap into the given heap leaving the 
+ * other heap empty. The given heap is resized if it doesn't have enough
+ * space. When the other heap is small its items are heapified up one at
+ * a time, otherwise the combined array is heapified from the bottom up.
+ * 
+ * Efficiency: O(n+m) where m is the number of items in the other heap.
+ * 
+ * @param h => The min heap to merge into.
+ * @param other => The min heap to take all items from.
+ */
+void minheap_merge(MinHeap* h, MinHeap* other);
+
+/**
+ * Removes every item from several heaps calling the method 'process' on
+ * each item in ascending order of key across all heaps. The heaps are
+ * sorted using at most one thread per processor, each taking the next
+ * unsorted heap, and then the sorted heaps are merged. The heaps must not
+ * be used by any other thread while they're drained.
+ * 
+ * Efficiency: O(n log n) split across the threads, then O(n log k) 
+ * 	where k is the number of heaps.
+ * 
+ * @param heaps => The array of min heaps to drain.
+ * @param count => The number of heaps in the array.
+ * @param process => The method that is called for every item in order.
+ */
+void minheap_drainSorted(MinHeap** heaps, unsigned int count, void (*process)(void* item));
+
 /**
  * Does a breadth first search on the heap and for each item traversed 
  * the method 'process' is called passing in that item.
@@ -0,0 +1,179 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _MULTI_LEVEL_QUEUE
+#define _MULTI_LEVEL_QUEUE
+
+#include "aqueue.h"
+
+// The most levels a multi-level queue can have, one per bit of a bitmap.
+#define MLQUEUE_MAX_LEVELS	32
+
+/**
+ * A level of a multi-level queue, holding its items along with counts of
+ * what has passed through it which can be read directly.
+ */
+typedef struct
+{
+	// The items waiting at this level.
+	ArrayQueue* queue;
+	// The number of items polled from this level in each round.
+	unsigned int weight;
+	// The number of items this level may still be polled for this round.
+	unsigned int deficit;
+
+	// The number of items ever offered to this level.
+	unsigned long offered;
+	// The number of items ever polled from this level.
+	unsigned long polled;
+	// The most items that have waited at this level at once.
+	unsigned int peak;
+
+} MultiLevelQueueLevel;
+
+/**
+ * A queue containing generic data at several priority levels which is
+ * polled using deficit round robin. Polling happens in rounds where every
+ * level is polled for up to its weight in items, starting at level 0, so
+ * higher levels get more of the queue without ever starving lower ones.
+ * A level that runs out of items gives up the rest of its round. Bitmaps
+ * of which levels have items and which have credit left find the next
+ * level to poll in O(1) no matter how many levels are empty. The
+ * operations that can be performed on a multi-level queue are:
+ * 
+ * Offer => Adds an item to the end of a level.
+ * Poll => Removes and returns the next item by deficit round robin.
+ * Peek => Returns the item that would be polled next.
+ * SetWeight => Changes the number of items polled from a level each round.
+ * LevelSize => Returns the number of items at a level.
+ * ResetStats => Resets the statistics of every level.
+ * Clear => Clears all items from the queue.
+ * Free => Frees the queue from memory.
+ * 
+ * Items must not be NULL since NULL is returned when the queue is empty.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The levels of the queue, level 0 is polled first in each round.
+	MultiLevelQueueLevel* levels;
+	// The number of levels.
+	unsigned int levelCount;
+	// The total number of items in the queue.
+	unsigned int size;
+	// A bit for every level which has items.
+	unsigned int waiting;
+	// A bit for every level which may still be polled this round.
+	unsigned int credited;
+
+} MultiLevelQueue;
+
+/**
+ * Returns an empty multi-level queue allocated to the heap.
+ * 
+ * @param levels => The number of levels, at most MLQUEUE_MAX_LEVELS.
+ * @param weights => The weight of every level, or NULL to weigh every
+ * 	level as 1. A weight of 0 is treated as 1.
+ */
+MultiLevelQueue* newMultiLevelQueue(unsigned int levels, unsigned int* weights);
+
+/**
+ * Adds an item to the end of a level of the queue. Returns false if the
+ * level doesn't exist or the item is NULL.
+ * 
+ * Efficiency: O(1) amortized
+ * 
+ * @param q => The multi-level queue to add to.
+ * @param level => The level to add the item to.
+ * @param item => The item to add.
+ */
+int mlqueue_offer(MultiLevelQueue* q, unsigned int level, void* item);
+
+/**
+ * Removes and returns the item at the front of the first level which has
+ * items and credit left in the current round, starting a new round when
+ * no level does. Returns NULL if the queue is empty.
+ * 
+ * Efficiency: O(1), O(l) when a new round starts.
+ * 
+ * @param q => The multi-level queue to poll from.
+ */
+void* mlqueue_poll(MultiLevelQueue* q);
+
+/**
+ * Returns the item that would be polled next without removing it, or NULL
+ * if the queue is empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The multi-level queue to peek at.
+ */
+void* mlqueue_peek(MultiLevelQueue* q);
+
+/**
+ * Changes the number of items polled from a level in each round, taking
+ * effect when the next round starts.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The multi-level queue with the level.
+ * @param level => The level to change the weight of.
+ * @param weight => The new weight, 0 is treated as 1.
+ */
+void mlqueue_setWeight(MultiLevelQueue* q, unsigned int level, unsigned int weight);
+
+/**
+ * Returns the number of items at a level, or 0 if it doesn't exist.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The multi-level queue with the level.
+ * @param level => The level to get the size of.
+ */
+unsigned int mlqueue_levelSize(MultiLevelQueue* q, unsigned int level);
+
+/**
+ * Returns true if the queue has no items at any level.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The multi-level queue to check for emptiness.
+ */
+int mlqueue_isEmpty(MultiLevelQueue* q);
+
+/**
+ * Resets the offered, polled, and peak counts of every level, where the
+ * peak starts again at the current size of the level.
+ * 
+ * Efficiency: O(l)
+ * 
+ * @param q => The multi-level queue to reset the statistics of.
+ */
+void mlqueue_resetStats(MultiLevelQueue* q);
+
+/**
+ * Clears every level of the queue of all items and starts a new round.
+ * 
+ * Efficiency: O(l)
+ * 
+ * @param q => The multi-level queue to clear all items from.
+ */
+void mlqueue_clear(MultiLevelQueue* q);
+
+/**
+ * Removes the queue completely from memory.
+ * 
+ * Efficiency: O(l)
+ * 
+ * @param q => The multi-level queue to free from memory.
+ */
+void mlqueue_free(MultiLevelQueue* q);
+
+#endif /* _MULTI_LEVEL_QUEUE */
\ No newline at end of file
@@ -0,0 +1,155 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _MPMC_QUEUE
+#define _MPMC_QUEUE
+
+#include <stdatomic.h>
+
+#include "cacheline.h"
+
+/**
+ * This is a slot in the ring of an mpmc queue. The sequence of a slot
+ * says whose turn it is: it equals the position of the next offer that may
+ * fill it, or that position plus one once it's filled and may be polled.
+ */
+typedef struct
+{
+	// The turn of this slot.
+	atomic_uint sequence;
+	// The item in this slot.
+	void* data;
+
+} MpmcSlot;
+
+/**
+ * A bounded array based queue containing generic data which any number of
+ * threads can offer to and poll from at the same time. Every slot in the
+ * ring has a sequence number, so a thread claims a position with a single
+ * compare-and-swap and then only waits on the one slot it claimed instead
+ * of a lock over the whole queue. Offer and Poll block until they can
+ * finish, sleeping on a futex where available, while TryOffer and TryPoll
+ * never block. The operations that can be performed on an mpmc queue are:
+ * 
+ * TryOffer => Adds an item to the end of the queue if it's not full.
+ * TryPoll => Removes and returns the item at the front of the queue if there is one.
+ * Offer => Adds an item to the end of the queue, waiting while it's full.
+ * Poll => Removes and returns the item at the front of the queue, waiting while it's empty.
+ * Size => Returns the number of items in the queue.
+ * Free => Frees the queue from memory.
+ * 
+ * Items must not be NULL since NULL is returned when the queue is empty.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The position of the next offer.
+	_Alignas(CACHE_LINE) atomic_uint tail;
+	// The position of the next poll.
+	_Alignas(CACHE_LINE) atomic_uint head;
+
+	// A counter bumped to wake threads waiting for an item.
+	_Alignas(CACHE_LINE) atomic_uint itemEvent;
+	// The number of threads waiting for an item.
+	atomic_uint itemWaiters;
+	// A counter bumped to wake threads waiting for a free slot.
+	atomic_uint slotEvent;
+	// The number of threads waiting for a free slot.
+	atomic_uint slotWaiters;
+
+	// The maximum number of items that can be in the queue.
+	_Alignas(CACHE_LINE) unsigned int capacity;
+	// The capacity minus one, used to wrap positions into the ring.
+	unsigned int mask;
+	// The ring of slots in the queue.
+	MpmcSlot* slots;
+
+} MpmcQueue;
+
+/**
+ * Returns an empty mpmc queue allocated to the heap.
+ * 
+ * @param capacity => The maximum number of items, rounded up to a power
+ * 	of 2 and at least 2.
+ */
+MpmcQueue* newMpmcQueue(unsigned int capacity);
+
+/**
+ * Adds an item to the end of the queue. This returns false right away if
+ * the queue is full.
+ * 
+ * Efficiency: O(1) without contention.
+ * 
+ * @param q => The mpmc queue to offer to.
+ * @param item => The item to add, which must not be NULL.
+ */
+int mpmc_tryOffer(MpmcQueue* q, void* item);
+
+/**
+ * Removes and returns the item at the front of the queue. This returns
+ * NULL right away if the queue is empty.
+ * 
+ * Efficiency: O(1) without contention.
+ * 
+ * @param q => The mpmc queue to poll from.
+ */
+void* mpmc_tryPoll(MpmcQueue* q);
+
+/**
+ * Adds an item to the end of the queue, sleeping while the queue is full.
+ * 
+ * Efficiency: O(1) without contention.
+ * 
+ * @param q => The mpmc queue to offer to.
+ * @param item => The item to add, which must not be NULL.
+ */
+void mpmc_offer(MpmcQueue* q, void* item);
+
+/**
+ * Removes and returns the item at the front of the queue, sleeping while
+ * the queue is empty.
+ * 
+ * Efficiency: O(1) without contention.
+ * 
+ * @param q => The mpmc queue to poll from.
+ */
+void* mpmc_poll(MpmcQueue* q);
+
+/**
+ * Returns the number of items in the queue. When called while other
+ * threads are using the queue this is only a snapshot.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The mpmc queue to get the size of.
+ */
+unsigned int mpmc_size(MpmcQueue* q);
+
+/**
+ * Returns true if the queue has no items. When called while other threads
+ * are using the queue this is only a snapshot.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The mpmc queue to check for emptiness.
+ */
+int mpmc_isEmpty(MpmcQueue* q);
+
+/**
+ * Removes the queue completely from memory. No threads may be using the
+ * queue.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The mpmc queue to free from memory.
+ */
+void mpmc_free(MpmcQueue* q);
+
+#endif /* _MPMC_QUEUE */
\ No newline at end of file
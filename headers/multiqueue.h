@@ -0,0 +1,147 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _MULTI_QUEUE
+#define _MULTI_QUEUE
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/**
+ * This is an entry in one of the heaps of a multi queue that holds
+ * generic data. Entries are stored by value in the heap's array.
+ */
+typedef struct
+{
+	// The data contained in this entry
+	void* data;
+	// The key used to sort this entry
+	int key;
+
+} MultiQueueEntry;
+
+/**
+ * This is one of the min heaps of a multi queue, each with its own lock.
+ */
+typedef struct
+{
+	// The lock held while the heap is being modified.
+	pthread_mutex_t lock;
+	// The key of the entry on top of the heap, readable without the lock.
+	// It's wider than a key so an empty heap has a top no key can equal.
+	atomic_llong top;
+	// The number of entries in this heap.
+	unsigned int size;
+	// The maximum number of entries in this heap before it grows.
+	unsigned int capacity;
+	// The array of entries that make up this heap.
+	MultiQueueEntry* entries;
+
+} MultiQueueHeap;
+
+/**
+ * A concurrent priority queue made up of several min heaps each protected
+ * by its own lock. Items are added to a random heap and popped from the
+ * better of two randomly chosen heaps, so threads rarely contend on the
+ * same lock. The order items are popped in is relaxed: the item popped is
+ * close to but not always the item with the lowest key. The operations
+ * that can be performed on a multi queue are:
+ *
+ * Add => Add an item to the multi queue given a key.
+ * PeekMin => Returns an item that has one of the lowest keys.
+ * PopMin => Removes and returns an item that has one of the lowest keys.
+ * Clear => Clears all items from the multi queue.
+ * Free => Frees the multi queue from memory.
+ *
+ * All operations except Clear and Free are safe to call from any thread.
+ *
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of items in this multi queue.
+	atomic_uint size;
+	// The number of heaps in this multi queue.
+	unsigned int count;
+	// The heaps that make up this multi queue.
+	MultiQueueHeap** heaps;
+
+} MultiQueue;
+
+/**
+ * Returns a new multi queue with no items. A good number of heaps is
+ * two to four times the number of threads using the queue.
+ *
+ * @param queues => The number of heaps in the multi queue.
+ * @param capacity => The initial capacity of each heap.
+ */
+MultiQueue* newMultiQueue(unsigned int queues, unsigned int capacity);
+
+/**
+ * Adds an item to a random heap in the multi queue. The heap will grow
+ * if it doesn't have enough space.
+ *
+ * Efficiency: O(h) where h is the height of the heap.
+ *
+ * @param q => The multi queue to add to.
+ * @param key => The value or key of the item to add.
+ * @param item => The generic data to add to the multi queue.
+ */
+void multiqueue_add(MultiQueue* q, int key, void* item);
+
+/**
+ * Removes an item with one of the lowest keys from the multi queue. If
+ * the multi queue is empty then NULL is returned.
+ *
+ * Efficiency: O(h) where h is the height of the heap.
+ *
+ * @param q => The multi queue to pop from.
+ */
+void* multiqueue_popMin(MultiQueue* q);
+
+/**
+ * Returns the item with the lowest key on top of any heap without
+ * removing it. Other threads may pop the item before it's used.
+ *
+ * Efficiency: O(k) where k is the number of heaps.
+ *
+ * @param q => The multi queue to peek from.
+ */
+void* multiqueue_peekMin(MultiQueue* q);
+
+/**
+ * Returns true if the multi queue has no items in it.
+ *
+ * Efficiency: O(1)
+ *
+ * @param q => The multi queue to check for emptiness.
+ */
+int multiqueue_isEmpty(MultiQueue* q);
+
+/**
+ * Clears the multi queue of all items. This must not be called while
+ * other threads are using the multi queue.
+ *
+ * Efficiency: O(k) where k is the number of heaps.
+ *
+ * @param q => The multi queue to clear of all items.
+ */
+void multiqueue_clear(MultiQueue* q);
+
+/**
+ * Clears the multi queue and frees it from memory. This must not be
+ * called while other threads are using the multi queue.
+ *
+ * Efficiency: O(k) where k is the number of heaps.
+ *
+ * @param q => The multi queue to free from memory.
+ */
+void multiqueue_free(MultiQueue* q);
+
+#endif /* _MULTI_QUEUE */
\ No newline at end of file
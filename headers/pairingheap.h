@@ -0,0 +1,228 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _PAIRING_HEAP
+#define _PAIRING_HEAP
+
+/**
+ * This is a node for a pairing heap that holds generic data. Every node
+ * has a list of children and a link to its next sibling.
+ */
+typedef struct PairingHeapNode
+{
+	// The data contained in this node
+	void* data;
+	// The key used to sort this node
+	int key;
+
+	// The first child of this node
+	struct PairingHeapNode* child;
+	// The next sibling of this node
+	struct PairingHeapNode* sibling;
+	// The previous sibling of this node, or its parent if it's the first child
+	struct PairingHeapNode* previous;
+
+} PairingHeapNode;
+
+/**
+ * This is a pairing heap containing generic data which is ordered by some
+ * key value. Unlike the array heaps two pairing heaps can be melded in
+ * constant time and the key of a node can be decreased in constant time.
+ * The operations that can be performed on a pairing heap are:
+ *
+ * Add => Add an item to the pairing heap given a key.
+ * PeekMin => Returns the item that has the lowest key.
+ * PopMin => Removes and returns the item that has the lowest key.
+ * Set => Sets an item with some key.
+ * Update => Updates some key with a new key.
+ * DecreaseKey => Decreases the key of a node returned from AddNode.
+ * Meld => Moves all items from one pairing heap into another.
+ * Traverse => Traverses the heap of items in no specific order.
+ * Clear => Clears all items from the heap.
+ * Free => Frees the heap from memory.
+ *
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of items in this heap.
+	unsigned int size;
+	// The node with the lowest key in this heap.
+	PairingHeapNode* root;
+
+} PairingHeap;
+
+/**
+ * Creates a pool of PairingHeapNodes.
+ *
+ * @param capacity => The maximum number of nodes that can be pooled.
+ */
+void pool_pairingheap(unsigned int capacity);
+
+/**
+ * Destroys the pool of PairingHeapNodes.
+ */
+void unpool_pairingheap();
+
+/**
+ * Returns a new pairing heap with no items.
+ */
+PairingHeap* newPairingHeap();
+
+/**
+ * Adds to the pairing heap. This always succeeds and returns true.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The pairing heap to add to.
+ * @param key => The value or key of the item to add.
+ * @param item => The generic data to add to the heap.
+ */
+int pairingheap_add(PairingHeap* h, int key, void* item);
+
+/**
+ * Adds to the pairing heap and returns the node holding the item. The node
+ * can be passed to DecreaseKey and RemoveNode until the item is removed,
+ * at which point the node is recycled and must not be used.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The pairing heap to add to.
+ * @param key => The value or key of the item to add.
+ * @param item => The generic data to add to the heap.
+ */
+PairingHeapNode* pairingheap_addNode(PairingHeap* h, int key, void* item);
+
+/**
+ * Gets the item with the specified key and returns it. If the key isn't
+ * found then NULL is returned.
+ *
+ * Efficiency: O(n)
+ *
+ * @param h => The pairing heap to search for a key.
+ * @param key => The key to search for in the pairing heap.
+ */
+void* pairingheap_get(PairingHeap* h, int key);
+
+/**
+ * Removes the item with the minimum key from the top of the heap and
+ * pairs up the children of the removed node to form the new heap.
+ *
+ * Efficiency: O(log n) amortized
+ *
+ * @param h => The pairing heap to pop from.
+ */
+void* pairingheap_popMin(PairingHeap* h);
+
+/**
+ * Returns the item at the top of the pairing heap without removing it.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The pairing heap to peek from.
+ */
+void* pairingheap_peekMin(PairingHeap* h);
+
+/**
+ * Sets the item with the specified key. If the key is not found in the
+ * heap then false is returned, a successful set returns true.
+ *
+ * Efficiency: O(n)
+ *
+ * @param h => The heap to search for a key and set its item.
+ * @param key => The key to seach for in the pairing heap.
+ * @param item => The new item at the key.
+ */
+int pairingheap_set(PairingHeap* h, int key, void* item);
+
+/**
+ * Updates an item's key on the heap with a new key. If the key is not
+ * found in the heap then false is returned.
+ *
+ * Efficiency: O(n)
+ *
+ * @param h => The pairing heap to update an item from.
+ * @param oldKey => The old key of the item to search for.
+ * @param newKey => The new key of the item.
+ */
+int pairingheap_update(PairingHeap* h, int oldKey, int newKey);
+
+/**
+ * Decreases the key of a node in the heap. If the new key is larger then
+ * the current key of the node then nothing is done and false is returned.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The pairing heap the node is in.
+ * @param node => The node returned from AddNode.
+ * @param key => The new key of the node.
+ */
+int pairingheap_decreaseKey(PairingHeap* h, PairingHeapNode* node, int key);
+
+/**
+ * Removes a node from anywhere in the heap and returns its item.
+ *
+ * Efficiency: O(log n) amortized
+ *
+ * @param h => The pairing heap the node is in.
+ * @param node => The node returned from AddNode.
+ */
+void* pairingheap_removeNode(PairingHeap* h, PairingHeapNode* node);
+
+/**
+ * Moves all items from the other heap into the given heap, leaving the
+ * other heap empty.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The pairing heap to meld into.
+ * @param other => The pairing heap to take all items from.
+ */
+void pairingheap_meld(PairingHeap* h, PairingHeap* other);
+
+/**
+ * Returns true if the pairing heap has no items in it.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The pairing heap to check for emptiness.
+ */
+int pairingheap_isEmpty(PairingHeap* h);
+
+/**
+ * Traverses the heap and for each item traversed the method 'process' is
+ * called passing in that item. Parents are traversed before children.
+ *
+ * Efficiency: O(n)
+ *
+ * @param h => The pairing heap to traverse.
+ * @param process => The method that is called every time an item is traversed.
+ */
+void pairingheap_traverse(PairingHeap* h, void (*process)(void* item));
+
+/**
+ * Clears the pairing heap of all items.
+ *
+ * Efficiency: O(n)
+ *
+ * @param h => The pairing heap to clear of all items.
+ */
+void pairingheap_clear(PairingHeap* h);
+
+/**
+ * Clears the pairing heap of all items and frees the nodes and the heap
+ * from memory.
+ *
+ * Efficiency: O(n)
+ *
+ * @param h => The pairing heap to clear and free from memory.
+ */
+void pairingheap_free(PairingHeap* h);
+
+#endif /* _PAIRING_HEAP */
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _PARALLEL
+#define _PARALLEL
+
+// The default number of indices a thread claims at a time.
+#define PARALLEL_CHUNK	4096
+
+/**
+ * Runs a loop over a range of indices on several threads. The range is cut
+ * into chunks and every thread, including the calling one, claims the next
+ * unclaimed chunk until none are left, so threads that finish early take
+ * on the work of slower ones. The other threads are tasks on the default
+ * Scheduler, so no threads are started per loop and a loop may run inside
+ * the body of another. The operations that can be performed are:
+ *
+ * Threads => Returns the number of processors available.
+ * For => Calls a method on every chunk of a range of indices.
+ * Reduce => Combines the results of every chunk of a range of indices.
+ *
+ * Example:
+ * 	void sum(unsigned int start, unsigned int end, void* arg) { ... }
+ * 	parallel_for(n, PARALLEL_CHUNK, 0, &sum, data);
+ *
+ * @author Philip Diffenderfer
+ */
+
+/**
+ * Returns the number of processors available to run threads on, which is
+ * at least one.
+ */
+unsigned int parallel_threads();
+
+/**
+ * Calls the body on every chunk of the indices from 0 up to but not
+ * including count, using the given number of threads. The body is called
+ * with the start index of the chunk, the index after the end of the
+ * chunk, and the argument given. This returns once every chunk is done.
+ *
+ * Efficiency: O(n/t) where 't' is the number of threads.
+ *
+ * @param count => The number of indices to loop over.
+ * @param chunk => The number of indices a thread claims at a time, 0 for
+ * 	PARALLEL_CHUNK.
+ * @param threads => The number of threads to use, 0 for one per processor.
+ * @param body => The method to call on every chunk.
+ * @param arg => The argument passed to every call of the body.
+ */
+void parallel_for(unsigned int count, unsigned int chunk, unsigned int threads,
+	void (*body)(unsigned int start, unsigned int end, void* arg), void* arg);
+
+/**
+ * Calls the body on every chunk of the indices from 0 up to but not
+ * including count, using the given number of threads, and combines the
+ * results the body returns. If deterministic is true the results are
+ * combined in the order of their chunks, so the result only depends on
+ * the chunk size and not on the number of threads or how they ran. If
+ * it's false the results are combined as chunks finish, which is only
+ * safe when the combine method is associative and commutative. NULL is
+ * returned if count is zero.
+ *
+ * Efficiency: O(n/t + c) where 't' is the number of threads and 'c' is
+ * 	the number of chunks.
+ *
+ * @param count => The number of indices to loop over.
+ * @param chunk => The number of indices a thread claims at a time, 0 for
+ * 	PARALLEL_CHUNK.
+ * @param threads => The number of threads to use, 0 for one per processor.
+ * @param body => The method that returns the result of a chunk.
+ * @param combine => The method that combines two results into one.
+ * @param arg => The argument passed to every call of the body.
+ * @param deterministic => Whether results are combined in chunk order.
+ */
+void* parallel_reduce(unsigned int count, unsigned int chunk, unsigned int threads,
+	void* (*body)(unsigned int start, unsigned int end, void* arg),
+	void* (*combine)(void* a, void* b), void* arg, int deterministic);
+
+#endif /* _PARALLEL */
\ No newline at end of file
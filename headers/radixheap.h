@@ -0,0 +1,134 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _RADIX_HEAP
+#define _RADIX_HEAP
+
+// The number of buckets in a radix heap, one more then the bits in a key.
+#define RADIXHEAP_BUCKETS	33
+
+/**
+ * This is an entry in a bucket of a radix heap that holds generic data.
+ */
+typedef struct
+{
+	// The data contained in this entry
+	void* data;
+	// The key used to sort this entry
+	unsigned int key;
+
+} RadixHeapEntry;
+
+/**
+ * This is a bucket of a radix heap which holds every entry whose key
+ * first differs from the last popped key at the same bit.
+ */
+typedef struct
+{
+	// The number of entries in this bucket.
+	unsigned int size;
+	// The maximum number of entries before the bucket grows.
+	unsigned int capacity;
+	// The array of entries in this bucket.
+	RadixHeapEntry* entries;
+
+} RadixHeapBucket;
+
+/**
+ * This is a radix heap containing generic data which is ordered by some
+ * key value. A radix heap is a monotone priority queue: an item can only
+ * be added with a key greater then or equal to the key of the last item
+ * popped, which is the case for the distances in shortest path searches.
+ * In return every operation takes amortized constant time. The operations
+ * that can be performed on a radix heap are:
+ *
+ * Add => Add an item to the radix heap given a key.
+ * PeekMin => Returns the item that has the lowest key.
+ * PopMin => Removes and returns the item that has the lowest key.
+ * Clear => Clears all items from the heap.
+ * Free => Frees the heap from memory.
+ *
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of items in this heap.
+	unsigned int size;
+	// The key of the last item popped, no smaller key can be added.
+	unsigned int last;
+	// The buckets of entries in this heap.
+	RadixHeapBucket buckets[RADIXHEAP_BUCKETS];
+
+} RadixHeap;
+
+/**
+ * Returns a new radix heap with no items.
+ */
+RadixHeap* newRadixHeap();
+
+/**
+ * Adds to the radix heap. If the key is smaller then the key of the last
+ * item popped the item is not added and false is returned.
+ *
+ * Efficiency: O(1) amortized
+ *
+ * @param h => The radix heap to add to.
+ * @param key => The value or key of the item to add.
+ * @param item => The generic data to add to the heap.
+ */
+int radixheap_add(RadixHeap* h, unsigned int key, void* item);
+
+/**
+ * Removes the item with the minimum key from the heap. Entries are only
+ * ever moved to buckets for lower bits so each entry is moved at most
+ * once for every bit in the key.
+ *
+ * Efficiency: O(1) amortized
+ *
+ * @param h => The radix heap to pop from.
+ */
+void* radixheap_popMin(RadixHeap* h);
+
+/**
+ * Returns the item with the minimum key without removing it.
+ *
+ * Efficiency: O(b) where b is the size of the lowest bucket with items.
+ *
+ * @param h => The radix heap to peek from.
+ */
+void* radixheap_peekMin(RadixHeap* h);
+
+/**
+ * Returns true if the radix heap has no items in it.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The radix heap to check for emptiness.
+ */
+int radixheap_isEmpty(RadixHeap* h);
+
+/**
+ * Clears the radix heap of all items. The next item added can have any key.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The radix heap to clear of all items.
+ */
+void radixheap_clear(RadixHeap* h);
+
+/**
+ * Clears the radix heap of all items and frees it from memory.
+ *
+ * Efficiency: O(1)
+ *
+ * @param h => The radix heap to clear and free from memory.
+ */
+void radixheap_free(RadixHeap* h);
+
+#endif /* _RADIX_HEAP */
\ No newline at end of file
@@ -0,0 +1,197 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _SMALL_ARRAY_LIST
+#define _SMALL_ARRAY_LIST
+
+// The number of items a small array list holds inside itself.
+#define SALIST_INLINE	8
+
+/**
+ * This is an array-list containing generic data that keeps its first few
+ * items inside the list itself. A list with no more then SALIST_INLINE
+ * items takes a single allocation, or none at all when the list is
+ * declared on the stack or inside another structure and started with
+ * salist_init. Once the list grows past that its items spill into an
+ * array on the heap like an ArrayList. Since the list may point into
+ * itself it must not be copied with memcpy or assignment. The operations
+ * that can be performed on a small array list are:
+ * 
+ * Init => Starts a list declared on the stack or in another structure.
+ * Add => Add an item to the end of the list.
+ * Insert => Insert an item into the list at some point.
+ * Remove => Remove an item from the list.
+ * RemoveAt => Remove an item at an index in the list.
+ * Reserve => Makes sure the list can hold some number of items.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Release => Frees any items spilled to the heap.
+ * Free => Frees the list from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of elements in this list.
+	unsigned int size;
+	// The maximum number of items that can be in the list
+	unsigned int capacity;
+	// The array of data in this list, either local or on the heap.
+	void** data;
+	// The array of data used until the list holds more then it can.
+	void* local[SALIST_INLINE];
+
+} SmallArrayList;
+
+/**
+ * Returns a new small array list with no items, allocated to the heap.
+ */
+SmallArrayList* newSmallArrayList();
+
+/**
+ * Starts a small array list that has been declared on the stack or inside
+ * another structure so it has no items. A list started this way must be
+ * released with salist_release instead of freed with salist_free.
+ * 
+ * @param l => The small array list to start.
+ */
+void salist_init(SmallArrayList* l);
+
+/**
+ * Returns the i'th item in the small array list.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The small array list to get from.
+ * @param index => The index of the data to get in the list.
+ */
+void* salist_get(SmallArrayList* l, unsigned int index);
+
+/**
+ * This will add an item to the end of the list, moving the items to the
+ * heap if the local array is full.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The small array list to add to.
+ * @param item => The generic data to add to the list.
+ */
+void salist_add(SmallArrayList* l, void* item);
+
+/**
+ * Inserts data into a small array list at the given index. If the index
+ * is past the end of the list the data is not added. This will return
+ * true if the data was added and false if not.
+ * 
+ * Efficiency: O(s-i) where 's' is the size of the list and 'i' is the index given.
+ * 
+ * @param l => The small array list to insert into.
+ * @param item => The generic data to insert into the list.
+ * @param index => The index at which to place the data.
+ */
+int salist_insert(SmallArrayList* l, void* item, unsigned int index);
+
+/**
+ * Removes and returns the item at the given index. If no item exists at
+ * the given index then NULL is returned.
+ * 
+ * Efficiency: O(s-i) where 's' is the size of the list and 'i' is the index given.
+ * 
+ * @param l => The small array list to remove from.
+ * @param index => The index of the item to remove.
+ */
+void* salist_removeAt(SmallArrayList* l, unsigned int index);
+
+/**
+ * Removes the first item from the list that equals the given item based
+ * on the equals method and returns it. If no item was equal then NULL is
+ * returned.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The small array list to remove from.
+ * @param item => The item to remove from the list.
+ * @param equals => The method that returns true if two items are equal.
+ */
+void* salist_remove(SmallArrayList* l, void* item, int (*equals)(void*, void*));
+
+/**
+ * Returns true if the small array list has no items in it.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The small array list to check for emptiness.
+ */
+int salist_isEmpty(SmallArrayList* l);
+
+/**
+ * Makes sure the list can hold at least the given number of items without
+ * growing, moving the items to the heap if the local array is too small.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The small array list to reserve space in.
+ * @param capacity => The number of items the list must be able to hold.
+ */
+void salist_reserve(SmallArrayList* l, unsigned int capacity);
+
+/**
+ * Traverse the list without affecting it starting at the front of the
+ * list and moving towards the back. Each item traversed will be sent
+ * through the process method.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The small array list to traverse from front-to-back.
+ * @param process => The method that is called every time an item is traversed.
+ */
+void salist_traverseForward(SmallArrayList* l, void (*process)(void* item));
+
+/**
+ * Traverse the list without affecting it starting at the back of the
+ * list and moving towards the front. Each item traversed will be sent
+ * through the process method.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The small array list to traverse from back-to-front.
+ * @param process => The method that is called every time an item is traversed.
+ */
+void salist_traverseBackward(SmallArrayList* l, void (*process)(void* item));
+
+/**
+ * Clears the list of all data, keeping any space on the heap.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The small array list to clear of all data.
+ */
+void salist_clear(SmallArrayList* l);
+
+/**
+ * Clears the list and frees any items spilled to the heap, leaving the
+ * list empty and using its local array again. This is how a list started
+ * with salist_init is destroyed.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The small array list to release.
+ */
+void salist_release(SmallArrayList* l);
+
+/**
+ * Removes the list completely from memory.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The small array list to clear and free from memory.
+ */
+void salist_free(SmallArrayList* l);
+
+#endif /* _SMALL_ARRAY_LIST */
\ No newline at end of file
@@ -0,0 +1,174 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _SCHEDULER
+#define _SCHEDULER
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "aqueue.h"
+#include "wsdeque.h"
+
+// The default number of indices run by one task of a parallel for.
+#define SCHEDULER_CHUNK	4096
+
+/**
+ * A group of tasks which can be waited on together. A group must be
+ * initialized before tasks are spawned into it and can be reused once
+ * every task in it is done.
+ */
+typedef struct
+{
+	// The number of tasks spawned into the group that haven't finished.
+	atomic_uint pending;
+
+} TaskGroup;
+
+/**
+ * A thread owned by a scheduler which runs tasks from its own deque and
+ * steals tasks from the deques of the other workers when its own is empty.
+ */
+typedef struct
+{
+	// The tasks spawned by this worker, stolen from the top by others.
+	WorkStealingDeque* deque;
+	// The scheduler this worker belongs to.
+	struct Scheduler* scheduler;
+	// The thread running this worker.
+	pthread_t thread;
+	// The state of the random number used to pick workers to steal from.
+	unsigned int seed;
+
+} SchedulerWorker;
+
+/**
+ * A fork-join scheduler which runs tasks on a fixed pool of worker threads.
+ * Every worker has a work-stealing deque, so the tasks a worker spawns run
+ * on that worker newest first while idle workers steal the oldest, which
+ * are usually the largest. Tasks spawned from threads that aren't workers
+ * go through a shared queue. A thread waiting on a group runs other tasks
+ * while it waits instead of blocking, so tasks may spawn and wait on tasks
+ * of their own. Idle workers sleep until a task is spawned. The operations
+ * that can be performed on a scheduler are:
+ * 
+ * Spawn => Adds a task to run later, optionally as part of a group.
+ * Wait => Runs tasks until every task in a group is done.
+ * ParallelFor => Calls a method on every chunk of a range of indices.
+ * Default => Returns a scheduler shared by the whole library.
+ * Free => Stops the workers and frees the scheduler from memory.
+ * 
+ * Example:
+ * 	TaskGroup g;
+ * 	taskgroup_init(&g);
+ * 	scheduler_spawn(s, &g, &sortLeft, data);
+ * 	scheduler_spawn(s, &g, &sortRight, data);
+ * 	scheduler_wait(s, &g);
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct Scheduler
+{
+	// The number of workers in the pool.
+	unsigned int workerCount;
+	// The workers in the pool.
+	SchedulerWorker* workers;
+
+	// The tasks spawned from threads that aren't workers.
+	ArrayQueue* submitted;
+	// The number of tasks in the submitted queue.
+	atomic_uint submittedCount;
+	// The lock guarding the submitted queue.
+	pthread_mutex_t submittedLock;
+
+	// A counter bumped whenever a task is spawned or a group finishes.
+	atomic_uint epoch;
+	// The number of threads sleeping until the epoch changes.
+	atomic_uint sleepers;
+	// The lock and condition threads sleep on.
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	// Whether the workers should keep running.
+	atomic_int running;
+
+} Scheduler;
+
+/**
+ * Returns a scheduler with its workers started, allocated to the heap.
+ * 
+ * @param threads => The number of worker threads, 0 for one per processor.
+ */
+Scheduler* newScheduler(unsigned int threads);
+
+/**
+ * Returns the scheduler shared by the library's parallel operations,
+ * starting it with one worker per processor the first time it's called.
+ * It lives until the process exits and must not be freed.
+ */
+Scheduler* scheduler_default();
+
+/**
+ * Initializes a group with no tasks.
+ * 
+ * @param g => The group to initialize.
+ */
+void taskgroup_init(TaskGroup* g);
+
+/**
+ * Adds a task to the scheduler to be run on some worker. When called from
+ * a worker of the scheduler the task goes on that worker's deque,
+ * otherwise it goes on the scheduler's shared queue.
+ * 
+ * Efficiency: O(1) amortized
+ * 
+ * @param s => The scheduler to run the task on.
+ * @param g => The group the task is part of, or NULL.
+ * @param run => The method of the task.
+ * @param arg => The argument passed to the method.
+ */
+void scheduler_spawn(Scheduler* s, TaskGroup* g, void (*run)(void* arg), void* arg);
+
+/**
+ * Returns once every task in the group is done. While the group has tasks
+ * running the calling thread runs any task it can find, and only sleeps
+ * when there are none.
+ * 
+ * @param s => The scheduler the group's tasks were spawned on.
+ * @param g => The group to wait on.
+ */
+void scheduler_wait(Scheduler* s, TaskGroup* g);
+
+/**
+ * Calls the body on every chunk of the indices from 0 up to but not
+ * including count, and returns once every chunk is done. The range is
+ * split in half repeatedly, spawning one half and keeping the other, so
+ * idle workers steal large ranges and split them further themselves.
+ * 
+ * Efficiency: O(n/t) where 't' is the number of workers.
+ * 
+ * @param s => The scheduler to run the loop on.
+ * @param count => The number of indices to loop over.
+ * @param chunk => The most indices passed to one call of the body, 0 for
+ * 	SCHEDULER_CHUNK.
+ * @param body => The method to call on every chunk.
+ * @param arg => The argument passed to every call of the body.
+ */
+void scheduler_parallelFor(Scheduler* s, unsigned int count, unsigned int chunk,
+	void (*body)(unsigned int start, unsigned int end, void* arg), void* arg);
+
+/**
+ * Stops the workers once they finish their current tasks and frees the
+ * scheduler from memory. Tasks that haven't started are discarded, so
+ * every group should be waited on first.
+ * 
+ * @param s => The scheduler to free from memory.
+ */
+void scheduler_free(Scheduler* s);
+
+#endif /* _SCHEDULER */
\ No newline at end of file
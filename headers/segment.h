@@ -0,0 +1,30 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _ARRAY_SEGMENT
+#define _ARRAY_SEGMENT
+
+/**
+ * A contiguous run of slots inside the array of a structure. The items of
+ * a ring based structure such as an ArrayQueue or ArrayDeque wrap around
+ * the end of their array, so they're exposed as at most two segments which
+ * can be read or written directly with memcpy, writev, and the like.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The first slot of the segment.
+	void** data;
+	// The number of slots in the segment.
+	unsigned int length;
+
+} ArraySegment;
+
+#endif /* _ARRAY_SEGMENT */
\ No newline at end of file
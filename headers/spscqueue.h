@@ -0,0 +1,156 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _SPSC_QUEUE
+#define _SPSC_QUEUE
+
+#include <stdatomic.h>
+
+#include "cacheline.h"
+
+/**
+ * An array based queue containing generic data which one thread offers to
+ * and another thread polls from at the same time without locks. Like the
+ * ArrayQueue it's a ring with a power of two capacity, but the head and
+ * tail are counters which only their own thread writes, kept on separate
+ * cache lines so the threads don't fight over the same line. Each thread
+ * also keeps the last value it read of the other thread's counter and only
+ * reads the real one again when the queue looks full or empty. Every
+ * operation finishes in a bounded number of steps. The operations that can
+ * be performed on an spsc queue are:
+ * 
+ * Offer => Adds an item to the end of the queue (producer only).
+ * OfferMany => Adds an array of items to the end of the queue (producer only).
+ * Poll => Removes and returns the item at the front of the queue (consumer only).
+ * PollMany => Removes items from the front of the queue into an array (consumer only).
+ * Peek => Returns the item at the front of the queue (consumer only).
+ * Size => Returns the number of items in the queue.
+ * Free => Frees the queue from memory.
+ * 
+ * Items must not be NULL since NULL is returned when the queue is empty.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of items polled, written only by the consumer.
+	_Alignas(CACHE_LINE) atomic_uint head;
+	// The last value of the tail read by the consumer.
+	unsigned int tailCache;
+
+	// The number of items offered, written only by the producer.
+	_Alignas(CACHE_LINE) atomic_uint tail;
+	// The last value of the head read by the producer.
+	unsigned int headCache;
+
+	// The maximum number of items that can be in the queue.
+	_Alignas(CACHE_LINE) unsigned int capacity;
+	// The capacity minus one, used to wrap counters into the array.
+	unsigned int mask;
+	// The ring of items in the queue.
+	void** data;
+
+} SpscQueue;
+
+/**
+ * Returns an empty spsc queue allocated to the heap.
+ * 
+ * @param capacity => The maximum number of items, rounded up to a power of 2.
+ */
+SpscQueue* newSpscQueue(unsigned int capacity);
+
+/**
+ * Adds an item to the end of the queue. This returns false if the queue
+ * is full. Only the producer thread may call this.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The spsc queue to offer to.
+ * @param item => The item to add, which must not be NULL.
+ */
+int spsc_offer(SpscQueue* q, void* item);
+
+/**
+ * Adds as many items from the array as fit to the end of the queue,
+ * making them visible to the consumer all at once. Returns the number of
+ * items added. Only the producer thread may call this.
+ * 
+ * Efficiency: O(k) where 'k' is the number of items added.
+ * 
+ * @param q => The spsc queue to offer to.
+ * @param items => The array of items to add.
+ * @param count => The number of items in the array.
+ */
+unsigned int spsc_offerMany(SpscQueue* q, void** items, unsigned int count);
+
+/**
+ * Removes and returns the item at the front of the queue. If the queue is
+ * empty then NULL is returned. Only the consumer thread may call this.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The spsc queue to poll from.
+ */
+void* spsc_poll(SpscQueue* q);
+
+/**
+ * Removes up to max items from the front of the queue and puts them in
+ * the buffer. Returns the number of items removed. Only the consumer
+ * thread may call this.
+ * 
+ * Efficiency: O(k) where 'k' is the number of items removed.
+ * 
+ * @param q => The spsc queue to poll from.
+ * @param buffer => The array to put the items in.
+ * @param max => The most items to remove.
+ */
+unsigned int spsc_pollMany(SpscQueue* q, void** buffer, unsigned int max);
+
+/**
+ * Returns the item at the front of the queue without removing it. If the
+ * queue is empty then NULL is returned. Only the consumer thread may call
+ * this.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The spsc queue to peek from.
+ */
+void* spsc_peek(SpscQueue* q);
+
+/**
+ * Returns the number of items in the queue. When called while the other
+ * thread is working this is only a snapshot.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The spsc queue to get the size of.
+ */
+unsigned int spsc_size(SpscQueue* q);
+
+/**
+ * Returns true if the queue has no items. When called while the other
+ * thread is working this is only a snapshot.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The spsc queue to check for emptiness.
+ */
+int spsc_isEmpty(SpscQueue* q);
+
+/**
+ * Removes the queue completely from memory. Neither thread may be using
+ * the queue.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param q => The spsc queue to free from memory.
+ */
+void spsc_free(SpscQueue* q);
+
+#endif /* _SPSC_QUEUE */
\ No newline at end of file
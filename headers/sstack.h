@@ -0,0 +1,135 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _SEGMENTED_STACK
+#define _SEGMENTED_STACK
+
+// The number of items in a chunk of a segmented stack.
+#define SSTACK_CHUNK	256
+
+/**
+ * A chunk of a segmented stack holding a fixed number of items.
+ */
+typedef struct SegmentedStackChunk
+{
+	// The chunk below this one, or NULL if this is the bottom chunk.
+	struct SegmentedStackChunk* below;
+	// The items in this chunk from the bottom up.
+	void* items[SSTACK_CHUNK];
+
+} SegmentedStackChunk;
+
+/**
+ * A stack containing generic data stored in fixed size chunks linked
+ * together. Unlike an ArrayStack it never copies its items to grow, and
+ * unlike a Stack it only allocates once per chunk instead of once per
+ * item, so every push and pop is O(1) in the worst case. An emptied chunk
+ * is kept as a spare for the next chunk needed, so pushing and popping
+ * back and forth across the edge of a chunk doesn't allocate and free a
+ * chunk every time. The operations that can be performed on a segmented
+ * stack are:
+ * 
+ * Pop => Removes and returns the item at the top of the stack.
+ * Peek => Returns the item at the top of the stack.
+ * Push => Adds an item to the top of the stack.
+ * Traverse => Traverses the stack of items from the top down.
+ * Clear => Clears all items from the stack.
+ * Free => Frees the stack from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of items on the stack.
+	unsigned int size;
+	// The number of items in the top chunk.
+	unsigned int count;
+	// The chunk holding the top of the stack, or NULL if none is allocated.
+	SegmentedStackChunk* top;
+	// An empty chunk kept for the next push that needs one, or NULL.
+	SegmentedStackChunk* spare;
+
+} SegmentedStack;
+
+/**
+ * Returns an empty segmented stack allocated to the heap.
+ */
+SegmentedStack* newSegmentedStack();
+
+/**
+ * Returns and removes the top item on the stack, or NULL if the stack is
+ * empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param s => The stack to pop from.
+ */
+void* sstack_pop(SegmentedStack* s);
+
+/**
+ * Returns the top item on the stack, or NULL if the stack is empty.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param s => The stack to peek at.
+ */
+void* sstack_peek(SegmentedStack* s);
+
+/**
+ * Adds an item to the top of the stack, taking the spare chunk or
+ * allocating a new one when the top chunk is full.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param s => The stack to push an item onto.
+ * @param item => The item to push onto the stack.
+ */
+void sstack_push(SegmentedStack* s, void* item);
+
+/**
+ * Returns true if the stack has no items.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param s => The stack to check for emptiness.
+ */
+int sstack_isEmpty(SegmentedStack* s);
+
+/**
+ * Traverse the stack without affecting it starting at the top of the
+ * stack and moving towards the bottom. Each item traversed will be sent
+ * through the process method.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param s => The stack to traverse from top-to-bottom.
+ * @param process => The method that is called every time an item is traversed.
+ */
+void sstack_traverseDown(SegmentedStack* s, void (*process)(void* item));
+
+/**
+ * Clears the stack of all items, freeing every chunk but one which is
+ * kept as the spare.
+ * 
+ * Efficiency: O(n/c) where 'c' is SSTACK_CHUNK.
+ * 
+ * @param s => The stack to clear all items from.
+ */
+void sstack_clear(SegmentedStack* s);
+
+/**
+ * Removes the stack and all of its chunks completely from memory.
+ * 
+ * Efficiency: O(n/c) where 'c' is SSTACK_CHUNK.
+ * 
+ * @param s => The stack to free from memory.
+ */
+void sstack_free(SegmentedStack* s);
+
+#endif /* _SEGMENTED_STACK */
\ No newline at end of file
@@ -0,0 +1,261 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _TYPED_ARRAY_LIST
+#define _TYPED_ARRAY_LIST
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A typed array-list stores its items by value in one contiguous array
+ * instead of storing pointers to items, so a list of a million ints is a
+ * single allocation and loops over its data can be vectorized. A typed
+ * list is generated for a type with two macros:
+ *
+ * ALIST_DECLARE(type) => Declares ArrayList_type and its functions, put
+ * 	this in a header.
+ * ALIST_DEFINE(type) => Defines the functions, put this in exactly one
+ * 	source file.
+ *
+ * The type must be a single identifier, so typedef types such as
+ * 'unsigned int' first. Lists of int, float, and double are already
+ * declared below and defined by the library. The operations are the same
+ * as the ArrayList with the type's name after 'alist_':
+ *
+ * Get => Returns the item at an index in the list.
+ * At => Returns a pointer to the item at an index in the list.
+ * Set => Sets the item at an index in the list.
+ * Add => Add an item to the end of the list.
+ * Insert => Insert an item into the list at some point.
+ * Remove => Remove an item from the list.
+ * RemoveAt => Remove an item at an index in the list.
+ * Resize => Changes the capacity of the array list.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Free => Frees the list from memory.
+ *
+ * Example:
+ * 	ArrayList_int* l = newArrayList_int(16);
+ * 	alist_int_add(l, 42);
+ * 	int x = alist_int_get(l, 0);
+ *
+ * @author Philip Diffenderfer
+ */
+
+/**
+ * Declares the typed array list ArrayList_type and all of its functions.
+ *
+ * @param type => The type of the items stored in the list.
+ */
+#define ALIST_DECLARE(type) \
+\
+typedef struct \
+{ \
+	/* The number of elements in this list. */ \
+	unsigned int size; \
+	/* The maximum number of items that can be in the list */ \
+	unsigned int capacity; \
+	/* The array of items in this list. */ \
+	type* data; \
+\
+} ArrayList_##type; \
+\
+/* Returns a new typed array list with no items, allocated to the heap. */ \
+ArrayList_##type* newArrayList_##type(unsigned int initialSize); \
+/* Returns the i'th item in the list or a zeroed item if out of bounds. */ \
+type alist_##type##_get(ArrayList_##type* l, unsigned int index); \
+/* Returns a pointer to the i'th item or NULL if out of bounds. */ \
+type* alist_##type##_at(ArrayList_##type* l, unsigned int index); \
+/* Sets the i'th item in the list, returns false if out of bounds. */ \
+int alist_##type##_set(ArrayList_##type* l, unsigned int index, type item); \
+/* Adds an item to the end of the list, doubling it when full. Returns */ \
+/* false if the list was full and couldn't grow. O(1) */ \
+int alist_##type##_add(ArrayList_##type* l, type item); \
+/* Inserts an item at an index, returns false if the index is past the */ \
+/* end of the list or the list couldn't grow. O(s-i) */ \
+int alist_##type##_insert(ArrayList_##type* l, type item, unsigned int index); \
+/* Removes the item at an index and copies it into 'removed' if it's not */ \
+/* NULL, returns false if the index is out of bounds. O(s-i) */ \
+int alist_##type##_removeAt(ArrayList_##type* l, unsigned int index, type* removed); \
+/* Removes the first item equal to the given item based on the equals */ \
+/* method, returns false if no item was equal. O(s) */ \
+int alist_##type##_remove(ArrayList_##type* l, type item, int (*equals)(type*, type*)); \
+/* Returns true if the list has no items. O(1) */ \
+int alist_##type##_isEmpty(ArrayList_##type* l); \
+/* Resizes the capacity of the list to at least 1, items past it are */ \
+/* removed. Returns false and changes nothing if it couldn't reallocate. */ \
+int alist_##type##_resize(ArrayList_##type* l, unsigned int newSize); \
+/* Calls process on every item from front to back. O(n) */ \
+void alist_##type##_traverseForward(ArrayList_##type* l, void (*process)(type* item)); \
+/* Calls process on every item from back to front. O(n) */ \
+void alist_##type##_traverseBackward(ArrayList_##type* l, void (*process)(type* item)); \
+/* Clears the list of all items. O(1) */ \
+void alist_##type##_clear(ArrayList_##type* l); \
+/* Removes the list completely from memory. O(1) */ \
+void alist_##type##_free(ArrayList_##type* l);
+
+/**
+ * Defines all of the functions of the typed array list ArrayList_type.
+ * The list must have been declared with ALIST_DECLARE first.
+ *
+ * @param type => The type of the items stored in the list.
+ */
+#define ALIST_DEFINE(type) \
+\
+ArrayList_##type* newArrayList_##type(unsigned int initialSize) \
+{ \
+	ArrayList_##type* l = malloc(sizeof(ArrayList_##type)); \
+\
+	l->size = 0; \
+	l->capacity = (initialSize == 0 ? 1 : initialSize); \
+	l->data = malloc(l->capacity * sizeof(type)); \
+\
+	return l; \
+} \
+\
+type alist_##type##_get(ArrayList_##type* l, unsigned int index) \
+{ \
+	if (index >= l->size) \
+	{ \
+		type empty; \
+		memset(&empty, 0, sizeof(type)); \
+		return empty; \
+	} \
+\
+	return l->data[index]; \
+} \
+\
+type* alist_##type##_at(ArrayList_##type* l, unsigned int index) \
+{ \
+	if (index >= l->size) \
+		return NULL; \
+\
+	return &l->data[index]; \
+} \
+\
+int alist_##type##_set(ArrayList_##type* l, unsigned int index, type item) \
+{ \
+	if (index >= l->size) \
+		return 0; \
+\
+	l->data[index] = item; \
+\
+	return 1; \
+} \
+\
+int alist_##type##_add(ArrayList_##type* l, type item) \
+{ \
+	if (l->size == l->capacity && !alist_##type##_resize(l, l->capacity << 1)) \
+		return 0; \
+\
+	l->data[l->size++] = item; \
+\
+	return 1; \
+} \
+\
+int alist_##type##_insert(ArrayList_##type* l, type item, unsigned int index) \
+{ \
+	if (index > l->size) \
+		return 0; \
+\
+	if (l->size == l->capacity && !alist_##type##_resize(l, l->capacity << 1)) \
+		return 0; \
+\
+	memmove(l->data + index + 1, l->data + index, \
+		(l->size - index) * sizeof(type)); \
+\
+	l->data[index] = item; \
+	l->size++; \
+\
+	return 1; \
+} \
+\
+int alist_##type##_removeAt(ArrayList_##type* l, unsigned int index, type* removed) \
+{ \
+	if (index >= l->size) \
+		return 0; \
+\
+	if (removed != NULL) \
+		*removed = l->data[index]; \
+\
+	l->size--; \
+	memmove(l->data + index, l->data + index + 1, \
+		(l->size - index) * sizeof(type)); \
+\
+	return 1; \
+} \
+\
+int alist_##type##_remove(ArrayList_##type* l, type item, int (*equals)(type*, type*)) \
+{ \
+	unsigned int i; \
+	for (i = 0; i < l->size; i++) \
+		if (equals(&item, &l->data[i])) \
+			return alist_##type##_removeAt(l, i, NULL); \
+\
+	return 0; \
+} \
+\
+int alist_##type##_isEmpty(ArrayList_##type* l) \
+{ \
+	return (l->size == 0); \
+} \
+\
+int alist_##type##_resize(ArrayList_##type* l, unsigned int newSize) \
+{ \
+	if (newSize == 0) \
+		newSize = 1; \
+\
+	/* The parentheses call the function, not util.h's realloc macro. */ \
+	type* data = (realloc)(l->data, newSize * sizeof(type)); \
+\
+	if (data == NULL) \
+		return 0; \
+\
+	l->size = (l->size < newSize ? l->size : newSize); \
+	l->capacity = newSize; \
+	l->data = data; \
+\
+	return 1; \
+} \
+\
+void alist_##type##_traverseForward(ArrayList_##type* l, void (*process)(type* item)) \
+{ \
+	unsigned int i; \
+	for (i = 0; i < l->size; i++) \
+		process(&l->data[i]); \
+} \
+\
+void alist_##type##_traverseBackward(ArrayList_##type* l, void (*process)(type* item)) \
+{ \
+	unsigned int i; \
+	for (i = l->size; i > 0; i--) \
+		process(&l->data[i - 1]); \
+} \
+\
+void alist_##type##_clear(ArrayList_##type* l) \
+{ \
+	l->size = 0; \
+} \
+\
+void alist_##type##_free(ArrayList_##type* l) \
+{ \
+	if (l == NULL) \
+		return; \
+\
+	free(l->data); \
+	free(l); \
+}
+
+// The typed array lists defined by the library.
+ALIST_DECLARE(int)
+ALIST_DECLARE(float)
+ALIST_DECLARE(double)
+
+#endif /* _TYPED_ARRAY_LIST */
\ No newline at end of file
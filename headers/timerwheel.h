@@ -0,0 +1,146 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _TIMER_WHEEL
+#define _TIMER_WHEEL
+
+// The number of bits of a tick each level of the wheel covers.
+#define TIMERWHEEL_BITS		8
+// The number of slots on each level of the wheel.
+#define TIMERWHEEL_SLOTS	(1 << TIMERWHEEL_BITS)
+// The number of levels in the wheel, enough to cover any unsigned int delay.
+#define TIMERWHEEL_LEVELS	4
+
+/**
+ * This is a node for a timer wheel that holds generic data. A node is
+ * returned when a timer is scheduled and can be used to cancel it.
+ */
+typedef struct TimerNode
+{
+	// The data contained in this node
+	void* data;
+	// The tick at which this timer expires
+	unsigned int expires;
+	// The previous node in the same slot
+	struct TimerNode* previous;
+	// The next node in the same slot
+	struct TimerNode* next;
+
+} TimerNode;
+
+/**
+ * A hierarchical timing wheel containing generic data which expires at some
+ * tick in the future. Each level holds timers which expire further in the
+ * future then the level below it, and as time advances the timers cascade
+ * down into the lower levels until they expire. The operations that can be
+ * performed on a timer wheel are:
+ *
+ * Schedule => Schedules an item to expire some number of ticks from now.
+ * Cancel => Cancels a scheduled timer before it expires.
+ * Advance => Moves time forward expiring any timers along the way.
+ * Clear => Clears all timers from the wheel.
+ * Free => Frees the wheel from memory.
+ *
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of timers scheduled in this wheel.
+	unsigned int size;
+	// The current tick of the wheel.
+	unsigned int now;
+	// The slots of every level, each slot is the head of a circular list.
+	TimerNode slots[TIMERWHEEL_LEVELS][TIMERWHEEL_SLOTS];
+
+} TimerWheel;
+
+/**
+ * Creates a pool of TimerNodes.
+ *
+ * @param capacity => The maximum number of nodes that can be pooled.
+ */
+void pool_timerwheel(unsigned int capacity);
+
+/**
+ * Destroys the pool of TimerNodes.
+ */
+void unpool_timerwheel();
+
+/**
+ * Returns a new timer wheel with no timers starting at tick 0.
+ */
+TimerWheel* newTimerWheel();
+
+/**
+ * Schedules an item to expire after the given number of ticks. The node
+ * returned can be used to cancel the timer until it expires or is
+ * cancelled, at which point the node is recycled and must not be used.
+ *
+ * Efficiency: O(1)
+ *
+ * @param w => The timer wheel to schedule on.
+ * @param delay => The number of ticks from now the timer expires.
+ * @param item => The generic data to hand back when the timer expires.
+ */
+TimerNode* timerwheel_schedule(TimerWheel* w, unsigned int delay, void* item);
+
+/**
+ * Cancels a timer that has not yet expired and returns its item. The
+ * node must not be passed again once the timer has expired or been
+ * cancelled, since by then it has been recycled.
+ *
+ * Efficiency: O(1)
+ *
+ * @param w => The timer wheel the timer was scheduled on.
+ * @param timer => The node returned when the timer was scheduled.
+ */
+void* timerwheel_cancel(TimerWheel* w, TimerNode* timer);
+
+/**
+ * Moves the wheel forward some number of ticks, for every timer that
+ * expires along the way the method 'expire' is called passing in its
+ * item. The number of timers that expired is returned.
+ *
+ * Efficiency: O(t+e) amortized where t is the number of ticks and e is
+ * 	the number of timers expired.
+ *
+ * @param w => The timer wheel to advance.
+ * @param ticks => The number of ticks to move forward.
+ * @param expire => The method that is called every time a timer expires.
+ */
+unsigned int timerwheel_advance(TimerWheel* w, unsigned int ticks, void (*expire)(void* item));
+
+/**
+ * Returns true if the timer wheel has no timers scheduled.
+ *
+ * Efficiency: O(1)
+ *
+ * @param w => The timer wheel to check for emptiness.
+ */
+int timerwheel_isEmpty(TimerWheel* w);
+
+/**
+ * Clears the timer wheel of all timers without expiring them.
+ *
+ * Efficiency: O(n+s) where s is the number of slots in the wheel.
+ *
+ * @param w => The timer wheel to clear of all timers.
+ */
+void timerwheel_clear(TimerWheel* w);
+
+/**
+ * Clears the timer wheel of all timers and frees the wheel from memory.
+ *
+ * Efficiency: O(n+s) where s is the number of slots in the wheel.
+ *
+ * @param w => The timer wheel to clear and free from memory.
+ */
+void timerwheel_free(TimerWheel* w);
+
+#endif /* _TIMER_WHEEL */
\ No newline at end of file
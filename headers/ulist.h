@@ -0,0 +1,238 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _UNROLLED_LIST
+#define _UNROLLED_LIST
+
+// The maximum number of items in a node of an unrolled list.
+#define ULIST_ITEMS	32
+
+/**
+ * This is a node for a doubly linked unrolled list that holds a run of
+ * generic data.
+ */
+typedef struct UnrolledListNode
+{
+	// The number of items in this node.
+	unsigned int count;
+	// The previous node in the list
+	struct UnrolledListNode* previous;
+	// The next node in the list
+	struct UnrolledListNode* next;
+	// The items in this node.
+	void* items[ULIST_ITEMS];
+
+} UnrolledListNode;
+
+/**
+ * This is an unrolled linked-list containing generic data. Each node holds
+ * up to ULIST_ITEMS items so adding an item rarely allocates and traversing
+ * reads items next to each other instead of chasing a pointer for every
+ * item. It has the same operations as the List including traversal with a
+ * cursor. The operations that can be performed on an unrolled list are:
+ * 
+ * Get => Gets an item at an index.
+ * Add => Add an item to the end of the list.
+ * AddFirst => Adds an item to the beginning of the list.
+ * RemoveFirst => Removes and Returns the first item in the list.
+ * Start => Starts the traversing of the list at the beginning.
+ * Peek => Returns the current item being traversed.
+ * Next => Goes to the next item to traverse.
+ * Remove => Removes the current item being traversed from the list.
+ * InsertAfter => Inserts an item after the current item being traversed.
+ * InsertBefore => Inserts an item before the current item being traversed.
+ * HasNext => Returns true when there's another item to traverse.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Free => Frees the list from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The number of elements in this list.
+	unsigned int size;
+
+	// The first node in this list.
+	UnrolledListNode* first;
+	// The last node in this list.
+	UnrolledListNode* last;
+
+	// The node of the current item being traversed.
+	UnrolledListNode* current;
+	// The index of the current item being traversed in its node.
+	unsigned int index;
+
+} UnrolledList;
+
+/**
+ * Creates a pool of UnrolledListNodes.
+ * 
+ * @param capacity => The maximum number of nodes that can be pooled.
+ */
+void pool_ulist(unsigned int capacity);
+
+/**
+ * Destroys the pool of UnrolledListNodes.
+ */
+void unpool_ulist();
+
+/**
+ * Returns a new unrolled list with no items, allocated to the heap.
+ */
+UnrolledList* newUnrolledList();
+
+/**
+ * Returns the i'th item in the list.
+ * 
+ * Efficiency: O(index/c) where 'c' is the number of items in a node.
+ * 
+ * @param l => The unrolled list to get from.
+ * @param index => The index of the item to return in the list.
+ */
+void* ulist_get(UnrolledList* l, unsigned int index);
+
+/**
+ * This will add an item to the end of the list.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The unrolled list to add to.
+ * @param data => The generic data to add to the end of the list.
+ */
+void ulist_add(UnrolledList* l, void* data);
+
+/**
+ * This will add an item to the beginning of the list.
+ * 
+ * Efficiency: O(c) where 'c' is the number of items in a node.
+ * 
+ * @param l => The unrolled list to add to.
+ * @param data => The generic data to add to the beginning of the list.
+ */
+void ulist_addFirst(UnrolledList* l, void* data);
+
+/**
+ * This will remove and return the item on the beginning of the list.
+ * 
+ * Efficiency: O(c) where 'c' is the number of items in a node.
+ * 
+ * @param l => The unrolled list to remove the first item from.
+ */
+void* ulist_removeFirst(UnrolledList* l);
+
+/**
+ * Returns true if this list has no items.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The unrolled list to check for emptiness.
+ */
+int ulist_isEmpty(UnrolledList* l);
+
+/**
+ * Starts the traversing of the unrolled list
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The unrolled list to start traversing.
+ */
+void ulist_start(UnrolledList* l);
+
+/**
+ * During list traversal this will return the current item without going to the next.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The unrolled list currently being traversed to return the current item.
+ */
+void* ulist_peek(UnrolledList* l);
+
+/**
+ * During list traversal this goes to the next item and returns it.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The unrolled list to proceed to the next item during traversal.
+ */
+void* ulist_next(UnrolledList* l);
+
+/**
+ * During list traversal this removes the current item from the list and
+ * returns it. A node left less then half full takes the items of the node
+ * after it if they fit.
+ * 
+ * Efficiency: O(c) where 'c' is the number of items in a node.
+ * 
+ * @param l => The unrolled list to remove the current item during traversal.
+ */
+void* ulist_remove(UnrolledList* l);
+
+/**
+ * During list traveral this will insert an item before the current item.
+ * If the traversal is done the item is added to the end of the list.
+ * 
+ * Efficiency: O(c) where 'c' is the number of items in a node.
+ * 
+ * @param l => The unrolled list to insert into before the current item during traversal.
+ * @param data => The generic data to insert before the current item.
+ */
+void ulist_insertBefore(UnrolledList* l, void* data);
+
+/**
+ * During list traveral this will insert an item after the current item.
+ * 
+ * Efficiency: O(c) where 'c' is the number of items in a node.
+ * 
+ * @param l => The unrolled list to insert into after the current item during traversal.
+ * @param data => The generic data to insert after the current item.
+ */
+void ulist_insertAfter(UnrolledList* l, void* data);
+
+/**
+ * During list traversal this returns whether there are more items 
+ * to traverse.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param l => The unrolled list being traversed.
+ */
+int ulist_hasNext(UnrolledList* l);
+
+/**
+ * Traverse the list without affecting it starting at the front of the
+ * list and moving towards the back. Each item traversed will be sent
+ * through the process method.
+ * 
+ * Efficiency: O(n)
+ * 
+ * @param l => The unrolled list to traverse.
+ * @param process => The method that is called every time an item is traversed.
+ */
+void ulist_traverse(UnrolledList* l, void (*process)(void* item));
+
+/**
+ * Clears the list of all data.
+ * 
+ * Efficiency: O(n/c) where 'c' is the number of items in a node.
+ * 
+ * @param l => The unrolled list to clear of all items.
+ */
+void ulist_clear(UnrolledList* l);
+
+/**
+ * Removes the list completely from memory.
+ * 
+ * Efficiency: O(n/c) where 'c' is the number of items in a node.
+ * 
+ * @param l => The unrolled list to clear and free from memory.
+ */
+void ulist_free(UnrolledList* l);
+
+#endif /* _UNROLLED_LIST */
\ No newline at end of file
@@ -12,6 +12,8 @@
 
 #include <stdlib.h>
 
+#include "cacheline.h"
+
 // Boolean constants
 #define true	1
 #define false 	0
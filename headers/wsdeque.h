@@ -0,0 +1,133 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#ifndef _WORK_STEALING_DEQUE
+#define _WORK_STEALING_DEQUE
+
+#include <stdatomic.h>
+
+#include "cacheline.h"
+
+/**
+ * This is the ring of items of a work-stealing deque. When the deque
+ * grows it moves to a ring twice as large and keeps the old one until the
+ * deque is freed, since a thief may still be reading from it.
+ */
+typedef struct WorkStealingArray
+{
+	// The number of slots in this ring, a power of 2.
+	long capacity;
+	// The ring of items.
+	_Atomic(void*)* items;
+	// The ring this one replaced, or NULL.
+	struct WorkStealingArray* previous;
+
+} WorkStealingArray;
+
+/**
+ * A Chase-Lev work-stealing deque containing generic data. It's shaped
+ * like an ArrayDeque where one thread, the owner, pushes and pops items at
+ * the bottom while any number of other threads, the thieves, steal items
+ * from the top. The owner only competes with thieves for the last item,
+ * so pushing and popping are usually plain reads and writes. The ring
+ * grows as needed so a push never fails. The operations that can be
+ * performed on a work-stealing deque are:
+ * 
+ * Push => Adds an item to the bottom of the deque (owner only).
+ * Pop => Removes and returns the item at the bottom of the deque (owner only).
+ * Steal => Removes and returns the item at the top of the deque (any thread).
+ * Size => Returns the number of items in the deque.
+ * Free => Frees the deque from memory.
+ * 
+ * Items must not be NULL since NULL is returned when the deque is empty.
+ * 
+ * @author Philip Diffenderfer
+ */
+typedef struct
+{
+	// The index of the item at the top, moved up by thieves and the owner.
+	_Alignas(CACHE_LINE) atomic_long top;
+	// The index after the item at the bottom, moved only by the owner.
+	_Alignas(CACHE_LINE) atomic_long bottom;
+	// The current ring of items.
+	_Alignas(CACHE_LINE) _Atomic(WorkStealingArray*) array;
+
+} WorkStealingDeque;
+
+/**
+ * Returns an empty work-stealing deque allocated to the heap.
+ * 
+ * @param capacity => The initial capacity, rounded up to a power of 2.
+ */
+WorkStealingDeque* newWorkStealingDeque(unsigned int capacity);
+
+/**
+ * Adds an item to the bottom of the deque, growing the ring if it's full.
+ * Only the owner may call this.
+ * 
+ * Efficiency: O(1) amortized
+ * 
+ * @param d => The work-stealing deque to push onto.
+ * @param item => The item to add, which must not be NULL.
+ */
+void wsdeque_push(WorkStealingDeque* d, void* item);
+
+/**
+ * Removes and returns the item at the bottom of the deque, which is the
+ * item pushed most recently. If the deque is empty, or a thief stole the
+ * last item first, then NULL is returned. Only the owner may call this.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param d => The work-stealing deque to pop from.
+ */
+void* wsdeque_pop(WorkStealingDeque* d);
+
+/**
+ * Removes and returns the item at the top of the deque, which is the
+ * oldest item. If the deque is empty, or another thread took the item
+ * first, then NULL is returned. Any thread may call this.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param d => The work-stealing deque to steal from.
+ */
+void* wsdeque_steal(WorkStealingDeque* d);
+
+/**
+ * Returns the number of items in the deque. When called while other
+ * threads are using the deque this is only a snapshot.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param d => The work-stealing deque to get the size of.
+ */
+unsigned int wsdeque_size(WorkStealingDeque* d);
+
+/**
+ * Returns true if the deque has no items. When called while other threads
+ * are using the deque this is only a snapshot.
+ * 
+ * Efficiency: O(1)
+ * 
+ * @param d => The work-stealing deque to check for emptiness.
+ */
+int wsdeque_isEmpty(WorkStealingDeque* d);
+
+/**
+ * Removes the deque and every ring it has used completely from memory. No
+ * threads may be using the deque.
+ * 
+ * Efficiency: O(log n) for the rings it grew out of.
+ * 
+ * @param d => The work-stealing deque to free from memory.
+ */
+void wsdeque_free(WorkStealingDeque* d);
+
+#endif /* _WORK_STEALING_DEQUE */
\ No newline at end of file
@@ -7,8 +7,11 @@
 
 \*****************************************************************************/
 
+#include <string.h>
+
 #include "util.h"
 #include "adeque.h"
+#include "parallel.h"
 
 /**
  * An array based deque containing generic data. The operations that can be 
@@ -18,16 +21,46 @@
  * PopLast => Removes and returns the item at the end of the deque.
  * PeekFirst => Returns the item on the front of the deque.
  * PeekLast => Returns the item at the end of the deque.
+ * Peek => Returns the item at an index in the deque.
+ * Set => Sets the item at an index in the deque.
+ * Rotate => Moves items from one end of the deque to the other.
+ * FromList => Returns a deque with the items of a List.
+ * FromQueue => Returns a deque with the items of a Queue.
  * PushFirst => Adds an item to the front of the deque.
  * PushLast => Adds an item to the end of the deque.
+ * ReadSegments => Returns the runs of items in the deque's array.
+ * CommitRead => Removes items read through the segments from the front.
+ * WriteSegments => Returns the runs of free slots after the end of the deque.
+ * CommitWrite => Adds items written through the segments to the end.
  * Resize => Doubles the capacity of the deque.
  * Traverse => Traverses the deque of items either forwards or backwards.
+ * ParallelForEach => Traverses the deque of items on several threads.
+ * ParallelMap => Maps every item into a new deque on several threads.
+ * ParallelReduce => Combines every item into one on several threads.
  * Clear => Clears all items from the deque.
  * Free => Frees the deque from memory.
  * 
  * @author Philip Diffenderfer
  */
 
+/**
+ * The arguments of a parallel traversal of a deque.
+ */
+typedef struct
+{
+	// The deque being traversed.
+	ArrayDeque* deque;
+	// The deque the mapped items are put in.
+	ArrayDeque* output;
+	// The method called on every item.
+	void (*process)(void* item);
+	// The method that maps every item.
+	void* (*map)(void* item);
+	// The method that combines two items.
+	void* (*reduce)(void* a, void* b);
+
+} ArrayDequeParallel;
+
 // Returns an empty deque allocated to the heap.
 ArrayDeque* newArrayDeque(unsigned int capacity)
 {
@@ -106,6 +139,84 @@ void* adeque_peek(ArrayDeque* q, unsigned int index)
 	return q->data[index];
 }
 
+// Sets the item at the specified index in the deque.
+int adeque_set(ArrayDeque* q, unsigned int index, void* item)
+{
+	if (index >= q->size)
+		return false;
+
+	q->data[(q->head + index) & (q->capacity - 1)] = item;
+
+	return true;
+}
+
+// Rotates the items of the deque by the given distance.
+void adeque_rotate(ArrayDeque* q, int distance)
+{
+	if (q->size == 0)
+		return;
+
+	int mod = (q->capacity - 1);
+	int moves = distance % q->size;
+
+	if (moves < 0)
+		moves += q->size;
+
+	// Moving k items from the end is the same as moving n-k from the front.
+	if (moves > q->size / 2)
+		moves -= q->size;
+
+	// When the deque is full the items are already in a circle.
+	if (q->size == q->capacity)
+	{
+		q->head = (q->head - moves) & mod;
+		q->tail = (q->tail - moves) & mod;
+		return;
+	}
+
+	for (; moves > 0; moves--)
+	{
+		q->head = (q->head - 1) & mod;
+		q->data[q->head] = q->data[q->tail];
+		q->tail = (q->tail - 1) & mod;
+	}
+
+	for (; moves < 0; moves++)
+	{
+		q->tail = (q->tail + 1) & mod;
+		q->data[q->tail] = q->data[q->head];
+		q->head = (q->head + 1) & mod;
+	}
+}
+
+// Returns a new deque with the items of the list in the same order.
+ArrayDeque* adeque_fromList(List* l)
+{
+	ArrayDeque* q = newArrayDeque(l->size);
+	ListNode* node;
+
+	for (node = l->first; node != NULL; node = node->next)
+		q->data[++q->tail] = node->data;
+
+	q->size = l->size;
+
+	return q;
+}
+
+// Returns a new deque with the items of the queue from front to back.
+ArrayDeque* adeque_fromQueue(Queue* queue)
+{
+	ArrayDeque* q = newArrayDeque(queue->size);
+	QueueNode* node;
+
+	for (node = queue->head; node != NULL; node = node->next)
+		q->data[++q->tail] = node->data;
+
+	q->size = queue->size;
+
+	return q;
+}
+
 // Adds an item to the front of a deque.
 int adeque_pushFirst(ArrayDeque* q, void* item)
 {
@@ -158,52 +269,84 @@ void adeque_pushfLast(ArrayDeque* q, void* item)
 	q->size++;
 }
 
+// Returns the runs of the deque's array holding its items.
+unsigned int adeque_readSegments(ArrayDeque* q, ArraySegment segments[2])
+{
+	unsigned int first = min((unsigned int)q->size, (unsigned int)(q->capacity - q->head));
+
+	segments[0].data = q->data + q->head;
+	segments[0].length = first;
+	segments[1].data = q->data;
+	segments[1].length = q->size - first;
+
+	return (q->size == 0 ? 0 : (segments[1].length == 0 ? 1 : 2));
+}
+
+// Removes items read through the segments from the front of a deque.
+int adeque_commitRead(ArrayDeque* q, unsigned int count)
+{
+	if (count > q->size)
+		return false;
+
+	q->head = (q->head + count) & (q->capacity - 1);
+	q->size -= count;
+
+	return true;
+}
+
+// Returns the runs of the deque's array that are free after its end.
+unsigned int adeque_writeSegments(ArrayDeque* q, ArraySegment segments[2])
+{
+	unsigned int available = q->capacity - q->size;
+	unsigned int start = (q->tail + 1) & (q->capacity - 1);
+	unsigned int first = min(available, q->capacity - start);
+
+	segments[0].data = q->data + start;
+	segments[0].length = first;
+	segments[1].data = q->data;
+	segments[1].length = available - first;
+
+	return (available == 0 ? 0 : (segments[1].length == 0 ? 1 : 2));
+}
+
+// Adds items written through the segments to the end of a deque.
+int adeque_commitWrite(ArrayDeque* q, unsigned int count)
+{
+	if (count > q->capacity - q->size)
+		return false;
+
+	q->tail = (q->tail + count) & (q->capacity - 1);
+	q->size += count;
+
+	return true;
+}
+
 // Resizes an deque to a new capacity.
 void adeque_resize(ArrayDeque* q, unsigned int capacity)
 {
+	// Find the next power of 2 number after capacity that fits every item
+	unsigned int actual = 1;
+	while (actual < capacity || actual < q->size)
+		actual <<= 1;
+
 	// Don't bother resizing to the same capacity
-	if (capacity == q->capacity)
+	if (actual == q->capacity)
 		return;
 
-	// Find the next power of 2 number after capacity
-	unsigned int actual = 1;
-	while (actual < capacity)
-		actual <<= 1;
+	ArraySegment segments[2];
+	void** data = alloc(void*, actual);
 
-	// Calculate the old and new capacities
-	unsigned int old = q->capacity;
-	unsigned int new = max(actual, q->size);
+	// Copy the items in order to the start of the new array.
+	adeque_readSegments(q, segments);
+	memcpy(data, segments[0].data, segments[0].length * sizeof(void*));
+	memcpy(data + segments[0].length, segments[1].data, segments[1].length * sizeof(void*));
 
-	q->capacity = new;
+	free(q->data);
 
-	int n, o, i = 0;
-	// If the deque was resized up then start at the head
-	if (old < new)
-	{
-		// Resize the data BEFORE to have the space
-		q->data = realloc(q->data, void*, new);
-
-		while (i < q->size)
-		{
-			n = (i + q->head) & (new - 1);
-			o = (i + q->head) & (old - 1);
-			q->data[n] = q->data[o];
-			i++;
-		}
-	}
-	// If the deque was sized down then start at the tail
-	else
-	{
-		while (i < q->size)
-		{
-			n = (q->tail - i) & (new - 1);
-			o = (q->tail - i) & (old - 1);
-			q->data[n] = q->data[o];
-			i++;
-		}
-		// Resize the data AFTER so no data is cut off.
-		q->data = realloc(q->data, void*, new);
-	}
+	q->data = data;
+	q->capacity = actual;
+	q->head = 0;
+	q->tail = q->size - 1;
 }
 
 // Returns whether the deque is empty or not.
@@ -252,6 +395,77 @@ void adeque_traverseBackward(ArrayDeque* q, void (*process)(void* item))
 	}
 }
 
+// Processes a chunk of a deque during a parallel for each.
+void adeque_forEachChunk(unsigned int start, unsigned int end, void* arg)
+{
+	ArrayDequeParallel* p = (ArrayDequeParallel*)arg;
+	ArrayDeque* q = p->deque;
+	int mod = (q->capacity - 1);
+
+	for (; start < end; start++)
+		p->process(q->data[(q->head + start) & mod]);
+}
+
+// Maps a chunk of a deque during a parallel map.
+void adeque_mapChunk(unsigned int start, unsigned int end, void* arg)
+{
+	ArrayDequeParallel* p = (ArrayDequeParallel*)arg;
+	ArrayDeque* q = p->deque;
+	int mod = (q->capacity - 1);
+
+	for (; start < end; start++)
+		p->output->data[start] = p->map(q->data[(q->head + start) & mod]);
+}
+
+// Combines a chunk of a deque into one during a parallel reduce.
+void* adeque_reduceChunk(unsigned int start, unsigned int end, void* arg)
+{
+	ArrayDequeParallel* p = (ArrayDequeParallel*)arg;
+	ArrayDeque* q = p->deque;
+	int mod = (q->capacity - 1);
+	void* result = q->data[(q->head + start) & mod];
+
+	while (++start < end)
+		result = p->reduce(result, q->data[(q->head + start) & mod]);
+
+	return result;
+}
+
+// Calls the process method on every item of the deque using several threads.
+void adeque_parallelForEach(ArrayDeque* q, void (*process)(void* item), unsigned int threads)
+{
+	ArrayDequeParallel p;
+	p.deque = q;
+	p.process = process;
+
+	parallel_for(q->size, PARALLEL_CHUNK, threads, &adeque_forEachChunk, &p);
+}
+
+// Returns a new deque with every item mapped using several threads.
+ArrayDeque* adeque_parallelMap(ArrayDeque* q, void* (*map)(void* item), unsigned int threads)
+{
+	ArrayDequeParallel p;
+	p.deque = q;
+	p.output = newArrayDeque(q->capacity);
+	p.output->size = q->size;
+	p.output->tail = q->size - 1;
+	p.map = map;
+
+	parallel_for(q->size, PARALLEL_CHUNK, threads, &adeque_mapChunk, &p);
+
+	return p.output;
+}
+
+// Combines every item of the deque into one using several threads.
+void* adeque_parallelReduce(ArrayDeque* q, void* (*reduce)(void* a, void* b), unsigned int threads, int deterministic)
+{
+	ArrayDequeParallel p;
+	p.deque = q;
+	p.reduce = reduce;
+
+	return parallel_reduce(q->size, PARALLEL_CHUNK, threads, &adeque_reduceChunk, reduce, &p, deterministic);
+}
+
 // Clears the deque of all items.
 int adeque_clear(ArrayDeque* q)
 {
@@ -274,6 +488,4 @@ void adeque_free(ArrayDeque* q)
 	adeque_clear(q);
 	free(q->data);
 	free(q);
-}
-
-#endif /* _ARRAY_DEQUE */
+}
\ No newline at end of file
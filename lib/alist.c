@@ -7,25 +7,105 @@
 
 \*****************************************************************************/
 
+// Lists can grow by remapping their pages where mremap is available.
+#ifdef __linux__
+#define _GNU_SOURCE
+#define ALIST_MREMAP
+#endif
+
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+
+#ifdef ALIST_MREMAP
+#include <sys/mman.h>
+#endif
+
 #include "util.h"
 #include "alist.h"
+#include "parallel.h"
 
 /**
  * This is an array-list containing generic data. The operations that can be 
  * performed on an array list are:
  * 
  * Add => Add an item to the end of the list
+ * AddAll => Add an array of items to the end of the list.
  * Insert => Insert an item into the list at some point
+ * InsertRange => Insert an array of items into the list at some point.
  * Remove => Remove an item from the list
  * RemoveAt => Remove an item at an index in the list.
+ * RemoveRange => Remove a range of items from the list.
+ * RemoveIf => Remove all items from the list that match a predicate.
  * Resize => Doubles the capacity of the array list
+ * Reserve => Makes sure the list can hold some number of items.
+ * ShrinkToFit => Releases any capacity not used by the items.
  * Traverse => Traverses the list of items
+ * ParallelForEach => Traverses the list of items on several threads.
+ * ParallelMap => Maps every item into a new list on several threads.
+ * ParallelReduce => Combines every item into one on several threads.
+ * Sort => Sorts the list by comparing items.
+ * SortByKey => Sorts the list by an integer key of each item.
+ * StableSort => Sorts the list keeping the order of equal items.
+ * ParallelSort => Sorts the list with several threads.
+ * BinarySearch => Finds an item in a sorted list.
  * Clear => Clears all items from the list
  * Free => Frees the list from memory.
  * 
  * @author Philip Diffenderfer
  */
 
+// The number of items in a range at which it's sorted by insertion.
+#define ALIST_INSERTION	16
+
+/**
+ * A range of a list that a thread sorts or merges during a parallel sort.
+ */
+typedef struct
+{
+	// The items being read.
+	void** source;
+	// The items being written by a merge.
+	void** destination;
+	// The start of the range, inclusive.
+	unsigned int start;
+	// The middle of the range where the second half being merged starts.
+	unsigned int middle;
+	// The end of the range, exclusive.
+	unsigned int end;
+	// The method that compares two items.
+	int (*compare)(void*, void*);
+
+} ArrayListRange;
+
+/**
+ * The arguments of a parallel traversal of a list.
+ */
+typedef struct
+{
+	// The list being traversed.
+	ArrayList* list;
+	// The list the mapped items are put in.
+	ArrayList* output;
+	// The method called on every item.
+	void (*process)(void* item);
+	// The method that maps every item.
+	void* (*map)(void* item);
+	// The method that combines two items.
+	void* (*reduce)(void* a, void* b);
+
+} ArrayListParallel;
+
+// A key extracted from an item paired with the item for sorting by key.
+typedef struct
+{
+	// The key of the item, flipped so it sorts as an unsigned number.
+	unsigned int key;
+	// The item with the key.
+	void* data;
+
+} ArrayListKeyed;
+
 // Returns a new array list with no data and an initial size of 16.
 ArrayList* emptyArrayList()
 {
@@ -40,10 +120,82 @@ ArrayList* newArrayList(unsigned int initialSize)
 	l->size = 0;
 	l->capacity = initialSize;
 	l->data = calloc(void*, initialSize);
+	l->growth = ALIST_GROWTH_DOUBLE;
+	l->mapThreshold = ALIST_MAP_THRESHOLD;
+	l->mapped = false;
 
 	return l;
 }
 
+// Reallocates the data of the list to hold the given capacity, mapping
+// it from the operating system once it's large enough. Returns NULL if
+// the data couldn't be reallocated, leaving the old data untouched.
+void** alist_reallocate(ArrayList* l, unsigned int capacity)
+{
+#ifdef ALIST_MREMAP
+	size_t bytes = (size_t)max(capacity, 1) * sizeof(void*);
+	size_t oldBytes = (size_t)max(l->capacity, 1) * sizeof(void*);
+	void* data;
+
+	// Mapped data is grown or shrunk by moving pages, not copying.
+	if (l->mapped)
+	{
+		data = mremap(l->data, oldBytes, bytes, MREMAP_MAYMOVE);
+
+		return (data == MAP_FAILED ? NULL : data);
+	}
+
+	// Large enough data is copied into mapped pages one last time.
+	if (l->mapThreshold > 0 && bytes >= l->mapThreshold)
+	{
+		data = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (data != MAP_FAILED)
+		{
+			memcpy(data, l->data, min(l->size, capacity) * sizeof(void*));
+			free(l->data);
+			l->mapped = true;
+
+			return data;
+		}
+	}
+#endif
+
+	// A capacity of 0 would free the data, so keep at least one slot.
+	return realloc(l->data, void*, max(capacity, 1));
+}
+
+// Returns the list's capacity times its growth factor, limited to the
+// largest capacity so the cast can't overflow.
+unsigned int alist_grown(ArrayList* l)
+{
+	double capacity = (double)l->capacity * l->growth;
+
+	return (capacity >= UINT_MAX ? UINT_MAX : (unsigned int)capacity);
+}
+
+// Grows a full list by its growth factor, returning false if the data
+// couldn't be reallocated.
+int alist_grow(ArrayList* l)
+{
+	unsigned int capacity = alist_grown(l);
+
+	return alist_resize(l, max(capacity, l->capacity + 1));
+}
+
+// Makes sure the list can hold the given number of items, growing it by
+// its growth factor or straight to the number of items if that's more.
+// Returns false if the data couldn't be reallocated.
+int alist_ensure(ArrayList* l, unsigned int needed)
+{
+	if (needed <= l->capacity)
+		return true;
+
+	unsigned int capacity = alist_grown(l);
+
+	return alist_resize(l, max(capacity, needed));
+}
+
 // Returns the i'th item in the array list.
 void* alist_get(ArrayList* l, unsigned int index)
 {
@@ -54,14 +206,16 @@ void* alist_get(ArrayList* l, unsigned int index)
 }
 
 // This will add an item to the end of the list.
-void alist_add(ArrayList* l, void* data)
+int alist_add(ArrayList* l, void* data)
 {
-	// If the list is full then resize it.
-	if (l->size == l->capacity)
-		alist_resize(l, l->capacity << 1);
+	// If the list is full then grow it.
+	if (l->size == l->capacity && !alist_grow(l))
+		return false;
 
 	l->data[l->size] = data;
 	l->size++;
+
+	return true;
 }
 
 // Inserts data into an array list at the given index. If the index is past
@@ -73,16 +227,11 @@ int alist_insert(ArrayList* l, void* data, unsigned int index)
 	if (index < 0 || index > l->size)
 		return false;
 
-	// If the list is full then resize it.
-	if (l->size == l->capacity)
-		alist_resize(l, l->capacity << 1);
+	// If the list is full then grow it.
+	if (l->size == l->capacity && !alist_grow(l))
+		return false;
 
-	unsigned int i = l->size;
-	while (i > index)
-	{
-		l->data[i] = l->data[i - 1];
-		i--;
-	}
+	memmove(l->data + index + 1, l->data + index, (l->size - index) * sizeof(void*));
 
 	l->data[index] = data;
 	l->size++;
@@ -90,6 +239,32 @@ int alist_insert(ArrayList* l, void* data, unsigned int index)
 	return true;
 }
 
+// This will add an array of items to the end of the list.
+int alist_addAll(ArrayList* l, void** items, unsigned int count)
+{
+	if (!alist_ensure(l, l->size + count))
+		return false;
+
+	memcpy(l->data + l->size, items, count * sizeof(void*));
+	l->size += count;
+
+	return true;
+}
+
+// Inserts an array of items into an array list at the given index,
+// shifting the items after the index once to make space for them all.
+int alist_insertRange(ArrayList* l, void** items, unsigned int count, unsigned int index)
+{
+	if (index > l->size || !alist_ensure(l, l->size + count))
+		return false;
+
+	memmove(l->data + index + count, l->data + index, (l->size - index) * sizeof(void*));
+	memcpy(l->data + index, items, count * sizeof(void*));
+	l->size += count;
+
+	return true;
+}
+
 // Removes and returns the item at the given index. If no item exists at the
 // given index or its completely outside the bounds of the list NULL is returned.
 void* alist_removeAt(ArrayList* l, unsigned int index)
@@ -99,18 +274,50 @@ void* alist_removeAt(ArrayList* l, unsigned int index)
 	
 	void* data = l->data[index];
 
-	while (index < l->size)
-	{
-		l->data[index] = l->data[index + 1];
-		index++;
-	}
-
 	l->size--;
+	memmove(l->data + index, l->data + index + 1, (l->size - index) * sizeof(void*));
 	l->data[l->size] = NULL;
 
 	return data;
 }
 
+// Removes the items from the start index up to but not including the end
+// index, shifting the items after them once.
+unsigned int alist_removeRange(ArrayList* l, unsigned int start, unsigned int end)
+{
+	end = min(end, l->size);
+
+	if (start >= end)
+		return 0;
+
+	unsigned int count = end - start;
+
+	memmove(l->data + start, l->data + end, (l->size - end) * sizeof(void*));
+	l->size -= count;
+	memset(l->data + l->size, 0, count * sizeof(void*));
+
+	return count;
+}
+
+// Removes every item for which the predicate returns true in a single
+// pass, keeping the remaining items in order.
+unsigned int alist_removeIf(ArrayList* l, int (*predicate)(void* item))
+{
+	unsigned int i, kept = 0;
+
+	// Slide every item that is kept down over the removed ones.
+	for (i = 0; i < l->size; i++)
+		if (!predicate(l->data[i]))
+			l->data[kept++] = l->data[i];
+
+	unsigned int count = l->size - kept;
+
+	memset(l->data + kept, 0, count * sizeof(void*));
+	l->size = kept;
+
+	return count;
+}
+
 // Removes and returns the item that is equal to the given item
 // based on the equal method passed in.
 void* alist_remove(ArrayList* l, void* item, int (*equals)(void*, void*))
@@ -134,11 +341,47 @@ int alist_isEmpty(ArrayList* l)
 // Resizes the given array list with a new capacity. If the new size passed
 // in is smaller then the number of items currently in the list then the
 // items at the end of the list are removed.
-void alist_resize(ArrayList* l, unsigned int newSize)
+int alist_resize(ArrayList* l, unsigned int newSize)
 {
+	void** data = alist_reallocate(l, newSize);
+
+	if (data == NULL)
+		return false;
+
 	l->size = min(l->size, newSize);
-	l->capacity = newSize;
-	l->data = realloc(l->data, void*, newSize);
+	l->capacity = max(newSize, 1);
+	l->data = data;
+
+	return true;
+}
+
+// Makes sure the list has room for at least the given number of items.
+void alist_reserve(ArrayList* l, unsigned int capacity)
+{
+	if (capacity > l->capacity)
+		alist_resize(l, capacity);
+}
+
+// Resizes the list so its capacity is the number of items in it.
+void alist_shrinkToFit(ArrayList* l)
+{
+	unsigned int capacity = max(l->size, 1);
+
+	if (capacity < l->capacity)
+		alist_resize(l, capacity);
+}
+
+// Sets the factor the capacity of the list is multiplied by when full.
+void alist_setGrowth(ArrayList* l, float factor)
+{
+	if (factor > 1.0f)
+		l->growth = factor;
+}
+
+// Sets the size in bytes at which the data of the list is mapped.
+void alist_setMapThreshold(ArrayList* l, size_t bytes)
+{
+	l->mapThreshold = bytes;
 }
 
 // Traverse the list without affecting it starting at the front of the
@@ -157,8 +400,449 @@ void alist_traverseForward(ArrayList* l, void (*process)(void* item))
 void alist_traverseBackward(ArrayList* l, void (*process)(void* item))
 {
 	unsigned int i;
-	for (i = l->size - 1; i >= 0; i--)
-		process(l->data[i]);
+	for (i = l->size; i > 0; i--)
+		process(l->data[i - 1]);
+}
+
+// Processes a chunk of a list during a parallel for each.
+void alist_forEachChunk(unsigned int start, unsigned int end, void* arg)
+{
+	ArrayListParallel* p = (ArrayListParallel*)arg;
+	void** data = p->list->data;
+
+	while (start < end)
+		p->process(data[start++]);
+}
+
+// Maps a chunk of a list during a parallel map.
+void alist_mapChunk(unsigned int start, unsigned int end, void* arg)
+{
+	ArrayListParallel* p = (ArrayListParallel*)arg;
+	void** data = p->list->data;
+	void** output = p->output->data;
+
+	for (; start < end; start++)
+		output[start] = p->map(data[start]);
+}
+
+// Combines a chunk of a list into one during a parallel reduce.
+void* alist_reduceChunk(unsigned int start, unsigned int end, void* arg)
+{
+	ArrayListParallel* p = (ArrayListParallel*)arg;
+	void** data = p->list->data;
+	void* result = data[start];
+
+	while (++start < end)
+		result = p->reduce(result, data[start]);
+
+	return result;
+}
+
+// Calls the process method on every item of the list using several threads.
+void alist_parallelForEach(ArrayList* l, void (*process)(void* item), unsigned int threads)
+{
+	ArrayListParallel p;
+	p.list = l;
+	p.process = process;
+
+	parallel_for(l->size, PARALLEL_CHUNK, threads, &alist_forEachChunk, &p);
+}
+
+// Returns a new list with every item mapped using several threads.
+ArrayList* alist_parallelMap(ArrayList* l, void* (*map)(void* item), unsigned int threads)
+{
+	ArrayListParallel p;
+	p.list = l;
+	p.output = newArrayList(max(l->size, 1));
+	p.output->size = l->size;
+	p.map = map;
+
+	parallel_for(l->size, PARALLEL_CHUNK, threads, &alist_mapChunk, &p);
+
+	return p.output;
+}
+
+// Combines every item of the list into one using several threads.
+void* alist_parallelReduce(ArrayList* l, void* (*reduce)(void* a, void* b), unsigned int threads, int deterministic)
+{
+	ArrayListParallel p;
+	p.list = l;
+	p.reduce = reduce;
+
+	return parallel_reduce(l->size, PARALLEL_CHUNK, threads, &alist_reduceChunk, reduce, &p, deterministic);
+}
+
+// Swaps two items in an array.
+void alist_swap(void** data, unsigned int i, unsigned int j)
+{
+	void* t = data[i];
+	data[i] = data[j];
+	data[j] = t;
+}
+
+// Sorts a small range of items by inserting each one into place.
+void alist_insertionSort(void** data, unsigned int size, int (*compare)(void*, void*))
+{
+	unsigned int i, j;
+	for (i = 1; i < size; i++)
+	{
+		void* item = data[i];
+
+		for (j = i; j > 0 && compare(item, data[j - 1]) < 0; j--)
+			data[j] = data[j - 1];
+
+		data[j] = item;
+	}
+}
+
+// Moves the item at the index down a max-heap until it's in place.
+void alist_siftDown(void** data, unsigned int index, unsigned int size, int (*compare)(void*, void*))
+{
+	unsigned int child;
+	while ((child = (index << 1) + 1) < size)
+	{
+		if (child + 1 < size && compare(data[child], data[child + 1]) < 0)
+			child++;
+
+		if (compare(data[index], data[child]) >= 0)
+			break;
+
+		alist_swap(data, index, child);
+		index = child;
+	}
+}
+
+// Sorts a range of items with a heapsort.
+void alist_heapSort(void** data, unsigned int size, int (*compare)(void*, void*))
+{
+	unsigned int i;
+	for (i = size >> 1; i > 0; i--)
+		alist_siftDown(data, i - 1, size, compare);
+
+	for (i = size - 1; i > 0; i--)
+	{
+		alist_swap(data, 0, i);
+		alist_siftDown(data, 0, i, compare);
+	}
+}
+
+// Sorts a range of items with a quicksort, falling back to a heapsort once
+// the depth runs out. Only the smaller side is recursed into.
+void alist_introSort(void** data, unsigned int size, unsigned int depth, int (*compare)(void*, void*))
+{
+	while (size > ALIST_INSERTION)
+	{
+		if (depth == 0)
+		{
+			alist_heapSort(data, size, compare);
+			return;
+		}
+		depth--;
+
+		// Order the first, middle, and last items so the ends stop the scans.
+		unsigned int middle = size >> 1;
+		unsigned int last = size - 1;
+
+		if (compare(data[middle], data[0]) < 0)
+			alist_swap(data, 0, middle);
+		if (compare(data[last], data[0]) < 0)
+			alist_swap(data, 0, last);
+		if (compare(data[last], data[middle]) < 0)
+			alist_swap(data, middle, last);
+
+		void* pivot = data[middle];
+		unsigned int i = 0;
+		unsigned int j = last;
+
+		for (;;)
+		{
+			do i++; while (compare(data[i], pivot) < 0);
+			do j--; while (compare(pivot, data[j]) < 0);
+
+			if (i >= j)
+				break;
+
+			alist_swap(data, i, j);
+		}
+
+		// Everything up to j is no greater then the pivot, the rest no less.
+		unsigned int left = j + 1;
+
+		if (left < size - left)
+		{
+			alist_introSort(data, left, depth, compare);
+			data += left;
+			size -= left;
+		}
+		else
+		{
+			alist_introSort(data + left, size - left, depth, compare);
+			size = left;
+		}
+	}
+
+	alist_insertionSort(data, size, compare);
+}
+
+// Merges the two sorted halves of a range of the source into the same
+// range of the destination, taking from the first half on ties.
+void alist_merge(ArrayListRange* r)
+{
+	void** source = r->source;
+	void** destination = r->destination;
+	unsigned int i = r->start;
+	unsigned int j = r->middle;
+	unsigned int k = r->start;
+
+	while (i < r->middle && j < r->end)
+	{
+		if (r->compare(source[j], source[i]) < 0)
+			destination[k++] = source[j++];
+		else
+			destination[k++] = source[i++];
+	}
+
+	memcpy(destination + k, source + i, (r->middle - i) * sizeof(void*));
+	k += r->middle - i;
+	memcpy(destination + k, source + j, (r->end - j) * sizeof(void*));
+}
+
+// Sorts the list in place with an introsort.
+void alist_sort(ArrayList* l, int (*compare)(void*, void*))
+{
+	if (l->size > 1)
+		alist_introSort(l->data, l->size, ilog2(l->size) << 1, compare);
+}
+
+// Sorts the list in place by the keys of the items with a radix sort.
+void alist_sortByKey(ArrayList* l, int (*key)(void*))
+{
+	unsigned int n = l->size;
+
+	if (n < 2)
+		return;
+
+	ArrayListKeyed* keyed = alloc(ArrayListKeyed, n);
+	ArrayListKeyed* buffer = alloc(ArrayListKeyed, n);
+	ArrayListKeyed* t;
+	unsigned int counts[256];
+	unsigned int i, shift, total, count;
+
+	// Flip the sign bit so negative keys sort before positive ones.
+	for (i = 0; i < n; i++)
+	{
+		keyed[i].key = (unsigned int)key(l->data[i]) ^ 0x80000000u;
+		keyed[i].data = l->data[i];
+	}
+
+	// Sort a byte at a time from the lowest, each pass keeps the order of
+	// the one before for equal bytes.
+	for (shift = 0; shift < 32; shift += 8)
+	{
+		memset(counts, 0, sizeof(counts));
+
+		for (i = 0; i < n; i++)
+			counts[(keyed[i].key >> shift) & 0xFF]++;
+
+		// Skip the pass if every key has the same byte.
+		if (counts[(keyed[0].key >> shift) & 0xFF] == n)
+			continue;
+
+		for (i = 0, total = 0; i < 256; i++)
+		{
+			count = counts[i];
+			counts[i] = total;
+			total += count;
+		}
+
+		for (i = 0; i < n; i++)
+			buffer[counts[(keyed[i].key >> shift) & 0xFF]++] = keyed[i];
+
+		t = keyed;
+		keyed = buffer;
+		buffer = t;
+	}
+
+	for (i = 0; i < n; i++)
+		l->data[i] = keyed[i].data;
+
+	free(keyed);
+	free(buffer);
+}
+
+// Sorts the list in place with a bottom up merge sort.
+void alist_stableSort(ArrayList* l, int (*compare)(void*, void*))
+{
+	unsigned int n = l->size;
+
+	if (n < 2)
+		return;
+
+	ArrayListRange r;
+	void** buffer = alloc(void*, n);
+	unsigned int i, width;
+
+	// Sort small runs by insertion, then merge runs back and forth between
+	// the list and the buffer doubling the width each time.
+	for (i = 0; i < n; i += ALIST_INSERTION)
+		alist_insertionSort(l->data + i, min(ALIST_INSERTION, n - i), compare);
+
+	r.source = l->data;
+	r.destination = buffer;
+	r.compare = compare;
+
+	for (width = ALIST_INSERTION; width < n; width <<= 1)
+	{
+		for (i = 0; i < n; i += width << 1)
+		{
+			r.start = i;
+			r.middle = min(i + width, n);
+			r.end = min(i + (width << 1), n);
+			alist_merge(&r);
+		}
+
+		r.destination = r.source;
+		r.source = (r.source == buffer ? l->data : buffer);
+	}
+
+	if (r.source != l->data)
+		memcpy(l->data, r.source, n * sizeof(void*));
+
+	free(buffer);
+}
+
+// Sorts one chunk of a list during a parallel sort.
+void* alist_sortThread(void* range)
+{
+	ArrayListRange* r = (ArrayListRange*)range;
+	unsigned int size = r->end - r->start;
+
+	alist_introSort(r->source + r->start, size, ilog2(size) << 1, r->compare);
+
+	return NULL;
+}
+
+// Merges two sorted chunks of a list during a parallel sort.
+void* alist_mergeThread(void* range)
+{
+	alist_merge((ArrayListRange*)range);
+
+	return NULL;
+}
+
+// Runs the method on every range, each on its own thread where one can be
+// started and otherwise on the calling thread.
+void alist_runThreads(ArrayListRange* ranges, unsigned int count, void* (*run)(void*))
+{
+	pthread_t* threads = alloc(pthread_t, count);
+	int* started = alloc(int, count);
+	unsigned int i;
+
+	for (i = 0; i < count; i++)
+	{
+		started[i] = (pthread_create(&threads[i], NULL, run, &ranges[i]) == 0);
+
+		if (!started[i])
+			run(&ranges[i]);
+	}
+
+	for (i = 0; i < count; i++)
+		if (started[i])
+			pthread_join(threads[i], NULL);
+
+	free(threads);
+	free(started);
+}
+
+// Sorts the list in place using the given number of threads.
+void alist_parallelSort(ArrayList* l, int (*compare)(void*, void*), unsigned int threads)
+{
+	unsigned int n = l->size;
+
+	if (threads < 2 || n < ALIST_PARALLEL_THRESHOLD)
+	{
+		alist_sort(l, compare);
+		return;
+	}
+
+	ArrayListRange* ranges = alloc(ArrayListRange, threads);
+	unsigned int* bounds = alloc(unsigned int, threads + 1);
+	void** buffer = alloc(void*, n);
+	void** source = l->data;
+	void** destination = buffer;
+	unsigned int chunks = threads;
+	unsigned int i, merges;
+
+	// Sort an even share of the list on each thread.
+	for (i = 0; i <= chunks; i++)
+		bounds[i] = (unsigned int)(((unsigned long long)n * i) / chunks);
+
+	for (i = 0; i < chunks; i++)
+	{
+		ranges[i].source = source;
+		ranges[i].start = bounds[i];
+		ranges[i].end = bounds[i + 1];
+		ranges[i].compare = compare;
+	}
+
+	alist_runThreads(ranges, chunks, &alist_sortThread);
+
+	// Merge neighboring chunks in pairs until one chunk is left, an odd
+	// chunk out is merged with nothing which copies it across.
+	while (chunks > 1)
+	{
+		merges = (chunks + 1) >> 1;
+
+		for (i = 0; i < merges; i++)
+		{
+			ranges[i].source = source;
+			ranges[i].destination = destination;
+			ranges[i].start = bounds[i << 1];
+			ranges[i].middle = bounds[min((i << 1) + 1, chunks)];
+			ranges[i].end = bounds[min((i << 1) + 2, chunks)];
+			ranges[i].compare = compare;
+		}
+
+		alist_runThreads(ranges, merges, &alist_mergeThread);
+
+		for (i = 0; i <= merges; i++)
+			bounds[i] = bounds[min(i << 1, chunks)];
+
+		chunks = merges;
+		destination = source;
+		source = (source == buffer ? l->data : buffer);
+	}
+
+	if (source != l->data)
+		memcpy(l->data, source, n * sizeof(void*));
+
+	free(ranges);
+	free(bounds);
+	free(buffer);
+}
+
+// Searches a sorted list for an item.
+int alist_binarySearch(ArrayList* l, void* item, int (*compare)(void*, void*))
+{
+	unsigned int low = 0;
+	unsigned int high = l->size;
+	unsigned int middle;
+	int c;
+
+	while (low < high)
+	{
+		middle = low + ((high - low) >> 1);
+		c = compare(l->data[middle], item);
+
+		if (c < 0)
+			low = middle + 1;
+		else if (c > 0)
+			high = middle;
+		else
+			return (int)middle;
+	}
+
+	return -(int)low - 1;
 }
 
 // Clears the list of all data.
@@ -174,6 +858,13 @@ void alist_free(ArrayList* l)
 		return;
 
 	alist_clear(l);
-	free(l->data);
+
+#ifdef ALIST_MREMAP
+	if (l->mapped)
+		munmap(l->data, (size_t)max(l->capacity, 1) * sizeof(void*));
+	else
+#endif
+		free(l->data);
+
 	free(l);
 }
@@ -14,6 +14,12 @@
  * Poll => Removes and returns the item at the front of the queue.
  * Peek => Returns the item at the front of the queue.
  * Offer => Adds an item to the end of the queue.
+ * OfferMany => Adds an array of items to the end of the queue.
+ * PollMany => Removes items from the front of the queue into an array.
+ * ReadSegments => Returns the runs of items in the queue's array.
+ * CommitRead => Removes items read through the segments from the front.
+ * WriteSegments => Returns the runs of free slots in the queue's array.
+ * CommitWrite => Adds items written through the segments to the end.
  * Resize => Doubles the capacity of the queue.
  * Traverse => Traverses the queue of items either forwards or backwards.
  * Clear => Clears all items from the queue.
@@ -22,6 +28,8 @@
  * @author Philip Diffenderfer
  */
 
+#include <string.h>
+
 #include "util.h"
 #include "aqueue.h"
 
@@ -98,6 +106,105 @@ int aqueue_offerf(ArrayQueue* q, void* item)
 	return true;
 }
 
+// Adds an array of items to the end of a queue.
+int aqueue_offerMany(ArrayQueue* q, void** items, unsigned int count)
+{
+	ArraySegment segments[2];
+
+	if (count > q->capacity - q->size)
+		return false;
+
+	// NULL is what poll returns for an empty queue, so like offer it can't
+	// be an item.
+	unsigned int i;
+	for (i = 0; i < count; i++)
+		if (items[i] == NULL)
+			return false;
+
+	aqueue_writeSegments(q, segments);
+
+	unsigned int first = min(count, segments[0].length);
+
+	memcpy(segments[0].data, items, first * sizeof(void*));
+	memcpy(segments[1].data, items + first, (count - first) * sizeof(void*));
+
+	return aqueue_commitWrite(q, count);
+}
+
+// Removes items from the front of a queue into a buffer.
+unsigned int aqueue_pollMany(ArrayQueue* q, void** buffer, unsigned int max)
+{
+	ArraySegment segments[2];
+
+	aqueue_readSegments(q, segments);
+
+	unsigned int count = min(max, (unsigned int)q->size);
+	unsigned int first = min(count, segments[0].length);
+
+	memcpy(buffer, segments[0].data, first * sizeof(void*));
+	memcpy(buffer + first, segments[1].data, (count - first) * sizeof(void*));
+
+	// Clear the slots like poll does so the queue doesn't hold onto them.
+	memset(segments[0].data, 0, first * sizeof(void*));
+	memset(segments[1].data, 0, (count - first) * sizeof(void*));
+
+	aqueue_commitRead(q, count);
+
+	return count;
+}
+
+// Returns the runs of the queue's array holding its items.
+unsigned int aqueue_readSegments(ArrayQueue* q, ArraySegment segments[2])
+{
+	unsigned int first = min((unsigned int)q->size, (unsigned int)(q->capacity - q->head));
+
+	segments[0].data = q->data + q->head;
+	segments[0].length = first;
+	segments[1].data = q->data;
+	segments[1].length = q->size - first;
+
+	return (q->size == 0 ? 0 : (segments[1].length == 0 ? 1 : 2));
+}
+
+// Removes items read through the segments from the front of a queue.
+int aqueue_commitRead(ArrayQueue* q, unsigned int count)
+{
+	if (count > q->size)
+		return false;
+
+	q->head = (q->head + count) & (q->capacity - 1);
+	q->size -= count;
+
+	return true;
+}
+
+// Returns the runs of the queue's array that are free.
+unsigned int aqueue_writeSegments(ArrayQueue* q, ArraySegment segments[2])
+{
+	unsigned int available = q->capacity - q->size;
+	unsigned int start = (q->tail + 1) & (q->capacity - 1);
+	unsigned int first = min(available, q->capacity - start);
+
+	segments[0].data = q->data + start;
+	segments[0].length = first;
+	segments[1].data = q->data;
+	segments[1].length = available - first;
+
+	return (available == 0 ? 0 : (segments[1].length == 0 ? 1 : 2));
+}
+
+// Adds items written through the segments to the end of a queue.
+int aqueue_commitWrite(ArrayQueue* q, unsigned int count)
+{
+	if (count > q->capacity - q->size)
+		return false;
+
+	q->tail = (q->tail + count) & (q->capacity - 1);
+	q->size += count;
+
+	return true;
+}
+
 // Resizes an array queue to a new capacity.
 void aqueue_resize(ArrayQueue* q, int capacity)
 {
@@ -182,6 +289,7 @@ int aqueue_clear(ArrayQueue* q)
 	if (q->size == 0)
 		return false;
 
+	q->size = 0;
 	q->head = 0;
 	q->tail = -1;
 
@@ -0,0 +1,298 @@
+/**
+ * Programmer: Philip Diffenderfer
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "alist.h"
+#include "aqueue.h"
+#include "minheap.h"
+#include "mpmcqueue.h"
+#include "multiqueue.h"
+#include "salist.h"
+
+// The thread counts each concurrent benchmark is run with.
+#define BENCHMARK_THREADS	4
+int threadCounts[BENCHMARK_THREADS] = {1, 2, 4, 8};
+
+// Runs the benchmark comparing a locked min heap to a multi queue
+void benchmarkMultiQueue();
+// Runs the benchmark comparing short array lists to small array lists
+void benchmarkSmallArrayList();
+// Runs the benchmark comparing a locked array queue to an mpmc queue
+void benchmarkMpmcQueue();
+
+int main(int argc, char* argv[])
+{
+	// Run the benchmarks
+	printf("\nMULTI QUEUE BENCHMARK\n\n");
+	benchmarkMultiQueue();
+
+	printf("\nSMALL ARRAY LIST BENCHMARK\n\n");
+	benchmarkSmallArrayList();
+
+	printf("\nMPMC QUEUE BENCHMARK\n\n");
+	benchmarkMpmcQueue();
+
+	return 0;
+}
+
+// Returns the current time in seconds.
+double now()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 0.000000001;
+}
+
+// Runs 'threads' threads of 'run' passing each the same argument and
+// returns the number of seconds it took for all of them to finish.
+double runThreads(int threads, void* (*run)(void*), void* argument)
+{
+	pthread_t ids[threads];
+	int i;
+
+	double start = now();
+
+	for (i = 0; i < threads; i++)
+		pthread_create(&ids[i], NULL, run, argument);
+	for (i = 0; i < threads; i++)
+		pthread_join(ids[i], NULL);
+
+	return now() - start;
+}
+
+// The number of add/pop pairs each thread does in the heap benchmarks.
+#define HEAP_OPERATIONS	1000000
+
+// The min heap and the lock shared by all threads.
+MinHeap* lockedHeap;
+pthread_mutex_t heapLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Adds and pops on the min heap holding the lock for each operation.
+void* runLockedHeap(void* argument)
+{
+	unsigned int seed = (unsigned int)(size_t)&seed;
+	int i;
+
+	for (i = 0; i < HEAP_OPERATIONS; i++)
+	{
+		pthread_mutex_lock(&heapLock);
+		minheap_addf(lockedHeap, rand_r(&seed) & 0xFFFF, argument);
+		pthread_mutex_unlock(&heapLock);
+
+		pthread_mutex_lock(&heapLock);
+		minheap_popMin(lockedHeap);
+		pthread_mutex_unlock(&heapLock);
+	}
+
+	return NULL;
+}
+
+// Adds and pops on the multi queue.
+void* runMultiQueue(void* argument)
+{
+	MultiQueue* q = argument;
+	unsigned int seed = (unsigned int)(size_t)&seed;
+	int i;
+
+	for (i = 0; i < HEAP_OPERATIONS; i++)
+	{
+		multiqueue_add(q, rand_r(&seed) & 0xFFFF, q);
+		multiqueue_popMin(q);
+	}
+
+	return NULL;
+}
+
+void benchmarkMultiQueue()
+{
+	int i, j, threads;
+	double locked, multi;
+
+	printf("%8s %16s %16s\n", "Threads", "MinHeap+Lock", "MultiQueue");
+
+	for (i = 0; i < BENCHMARK_THREADS; i++)
+	{
+		threads = threadCounts[i];
+
+		// Start both with the same number of items so pops never find
+		// the queue empty.
+		lockedHeap = newMinHeap(1 << 16);
+		MultiQueue* q = newMultiQueue(threads * 4, 1 << 12);
+
+		for (j = 0; j < (1 << 14); j++)
+		{
+			minheap_addf(lockedHeap, j, q);
+			multiqueue_add(q, j, q);
+		}
+
+		locked = runThreads(threads, &runLockedHeap, q);
+		multi = runThreads(threads, &runMultiQueue, q);
+
+		// Show how many millions of operations a second each managed
+		printf("%8d %13.2f M/s %13.2f M/s\n", threads,
+			threads * HEAP_OPERATIONS * 2 / locked / 1000000.0,
+			threads * HEAP_OPERATIONS * 2 / multi / 1000000.0);
+
+		minheap_free(lockedHeap);
+		multiqueue_free(q);
+	}
+}
+
+// The number of lists built and thrown away in the small list benchmarks.
+#define LIST_OPERATIONS	2000000
+
+// The number of items put in each list in the small list benchmarks.
+#define LIST_SIZES	4
+int listSizes[LIST_SIZES] = {2, 4, 8, 16};
+
+// Builds, reads, and frees array lists of the given size.
+double runArrayList(int size)
+{
+	size_t sum = 0;
+	int i, j;
+
+	double start = now();
+
+	for (i = 0; i < LIST_OPERATIONS; i++)
+	{
+		ArrayList* l = newArrayList(SALIST_INLINE);
+
+		for (j = 0; j < size; j++)
+			alist_add(l, &listSizes[j & 3]);
+		for (j = 0; j < size; j++)
+			sum += (size_t)alist_get(l, j);
+
+		alist_free(l);
+	}
+
+	double elapsed = now() - start;
+
+	// Use the sum so the reads can't be optimized away.
+	return (sum == 0 ? 0.0 : elapsed);
+}
+
+// Builds, reads, and frees small array lists of the given size.
+double runSmallArrayList(int size)
+{
+	size_t sum = 0;
+	int i, j;
+
+	double start = now();
+
+	for (i = 0; i < LIST_OPERATIONS; i++)
+	{
+		SmallArrayList* l = newSmallArrayList();
+
+		for (j = 0; j < size; j++)
+			salist_add(l, &listSizes[j & 3]);
+		for (j = 0; j < size; j++)
+			sum += (size_t)salist_get(l, j);
+
+		salist_free(l);
+	}
+
+	double elapsed = now() - start;
+
+	return (sum == 0 ? 0.0 : elapsed);
+}
+
+void benchmarkSmallArrayList()
+{
+	int i, size;
+	double array, small;
+
+	printf("%8s %16s %16s\n", "Items", "ArrayList", "SmallArrayList");
+
+	for (i = 0; i < LIST_SIZES; i++)
+	{
+		size = listSizes[i];
+
+		array = runArrayList(size);
+		small = runSmallArrayList(size);
+
+		// Show how many millions of lists a second each managed
+		printf("%8d %13.2f M/s %13.2f M/s\n", size,
+			LIST_OPERATIONS / array / 1000000.0,
+			LIST_OPERATIONS / small / 1000000.0);
+	}
+}
+
+// The number of offer/poll pairs each thread does in the queue benchmarks.
+#define QUEUE_OPERATIONS	1000000
+
+// The array queue and the lock shared by all threads.
+ArrayQueue* lockedQueue;
+pthread_mutex_t queueLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Offers and polls on the array queue holding the lock for each operation.
+void* runLockedQueue(void* argument)
+{
+	int i;
+
+	for (i = 0; i < QUEUE_OPERATIONS; i++)
+	{
+		pthread_mutex_lock(&queueLock);
+		aqueue_offer(lockedQueue, argument);
+		pthread_mutex_unlock(&queueLock);
+
+		pthread_mutex_lock(&queueLock);
+		aqueue_poll(lockedQueue);
+		pthread_mutex_unlock(&queueLock);
+	}
+
+	return NULL;
+}
+
+// Offers and polls on the mpmc queue.
+void* runMpmcQueue(void* argument)
+{
+	MpmcQueue* q = argument;
+	int i;
+
+	for (i = 0; i < QUEUE_OPERATIONS; i++)
+	{
+		mpmc_offer(q, q);
+		mpmc_poll(q);
+	}
+
+	return NULL;
+}
+
+void benchmarkMpmcQueue()
+{
+	int i, j, threads;
+	double locked, mpmc;
+
+	printf("%8s %16s %16s\n", "Threads", "ArrayQueue+Lock", "MpmcQueue");
+
+	for (i = 0; i < BENCHMARK_THREADS; i++)
+	{
+		threads = threadCounts[i];
+
+		// Start both half full so offers and polls never block.
+		lockedQueue = newArrayQueue(1 << 12);
+		MpmcQueue* q = newMpmcQueue(1 << 12);
+
+		for (j = 0; j < (1 << 11); j++)
+		{
+			aqueue_offer(lockedQueue, q);
+			mpmc_offer(q, q);
+		}
+
+		locked = runThreads(threads, &runLockedQueue, q);
+		mpmc = runThreads(threads, &runMpmcQueue, q);
+
+		// Show how many millions of operations a second each managed
+		printf("%8d %13.2f M/s %13.2f M/s\n", threads,
+			threads * QUEUE_OPERATIONS * 2 / locked / 1000000.0,
+			threads * QUEUE_OPERATIONS * 2 / mpmc / 1000000.0);
+
+		aqueue_free(lockedQueue);
+		mpmc_free(q);
+	}
+}
\ No newline at end of file
@@ -50,55 +50,55 @@ typedef struct
 
 
 // The pool to use for any BinaryTree's nodes.
-Pool* pool;
+Pool* treePool;
 
 
 // Creates a pool of BinaryTreeNode.
 void pool_binary(unsigned int capacity)
 {
-	pool = alloc(Pool, 1);
+	treePool = alloc(Pool, 1);
 
-	pool->capacity = capacity;
-	pool->size = 0;
-	pool->nodes = alloc(BinaryTreeNode*, capacity);
+	treePool->capacity = capacity;
+	treePool->size = 0;
+	treePool->nodes = alloc(BinaryTreeNode*, capacity);
 }
 
 // Destroys the pool of BinaryTreeNode.
 void unpool_binary()
 {
-	if (pool == NULL)
+	if (treePool == NULL)
 		return;
 
 	unsigned int i;
-	for (i = 0; i < pool->size; i++)
-		free(pool->nodes[i]);
+	for (i = 0; i < treePool->size; i++)
+		free(treePool->nodes[i]);
 
-	free(pool->nodes);
-	free(pool);
+	free(treePool->nodes);
+	free(treePool);
 
-	pool = NULL;
+	treePool = NULL;
 }
 
 // Returns a node from the pool or allocates a new one.
 BinaryTreeNode* pop_BinaryTreeNode()
 {
 	// Of pooling isn't supported then just allocate a new one.
-	if (pool == NULL)
+	if (treePool == NULL)
 		return alloc(BinaryTreeNode, 1);
 
 	BinaryTreeNode* node;
 
 	// If there are none on the pool then allocate a new one
-	if (pool->size == 0)
+	if (treePool->size == 0)
 	{
 		node = alloc(BinaryTreeNode, 1);
 	}
 	// If there is one on the pool grab one from the back.
 	else
 	{
-		pool->size--;
-		node = pool->nodes[pool->size];
-		pool->nodes[pool->size] = NULL;
+		treePool->size--;
+		node = treePool->nodes[treePool->size];
+		treePool->nodes[treePool->size] = NULL;
 	}
 
 	return node;
@@ -111,20 +111,20 @@ void push_BinaryTreeNode(BinaryTreeNode* node)
 	if (node == NULL)
 		return;
 	// If the pooling isn't supported then just free the node from memory.
-	else if (pool == NULL)
+	else if (treePool == NULL)
 	{
 		free(node);	
 		return;
 	}
 	// If the pool exists but is filled then exit.
-	else if (pool->size == pool->capacity)
+	else if (treePool->size == treePool->capacity)
 		return;
 
 	// push the node into the pool.
 	node->data = NULL;
 	node->left = NULL;
 	node->right = NULL;
-	pool->nodes[pool->size++] = node;
+	treePool->nodes[treePool->size++] = node;
 }
 
 
@@ -0,0 +1,257 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * A bounded array based queue containing generic data which threads can
+ * hand items off through. The operations that can be performed on a
+ * blocking queue are:
+ * 
+ * Offer => Adds an item to the end of the queue, waiting while it's full.
+ * OfferTimeout => Adds an item to the end of the queue, waiting a limited time while it's full.
+ * Poll => Removes and returns the item at the front of the queue, waiting while it's empty.
+ * PollTimeout => Removes and returns the item at the front of the queue, waiting a limited time while it's empty.
+ * DrainTo => Removes many items from the front of the queue into a buffer.
+ * Size => Returns the number of items in the queue.
+ * Free => Frees the queue from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+#include <time.h>
+#include <errno.h>
+#include <string.h>
+
+#include "util.h"
+#include "bqueue.h"
+
+// Returns the time the given number of milliseconds from now on the clock
+// the queue's conditions wait against.
+struct timespec bqueue_deadline(unsigned int millis)
+{
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+	deadline.tv_sec += millis / 1000;
+	deadline.tv_nsec += (long)(millis % 1000) * 1000000L;
+
+	if (deadline.tv_nsec >= 1000000000L)
+	{
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	return deadline;
+}
+
+// Waits on a condition until it's signalled or the deadline passes, or
+// forever if the deadline is NULL. Returns false if the deadline passed.
+int bqueue_wait(BlockingQueue* q, pthread_cond_t* cond, unsigned int* waiters, struct timespec* deadline)
+{
+	int result = 0;
+
+	(*waiters)++;
+
+	if (deadline == NULL)
+		pthread_cond_wait(cond, &q->lock);
+	else
+		result = pthread_cond_timedwait(cond, &q->lock, deadline);
+
+	(*waiters)--;
+
+	return (result != ETIMEDOUT);
+}
+
+// Adds an item to the tail of the ring, the lock must be held and the ring
+// must have room.
+void bqueue_push(BlockingQueue* q, void* item)
+{
+	q->data[q->tail] = item;
+	q->tail = (q->tail + 1 == q->capacity ? 0 : q->tail + 1);
+	q->size++;
+
+	if (q->pollWaiters > 0)
+		pthread_cond_signal(&q->notEmpty);
+}
+
+// Removes up to max items from the head of the ring into the buffer, the
+// lock must be held. Returns the number of items removed.
+unsigned int bqueue_pop(BlockingQueue* q, void** buffer, unsigned int max)
+{
+	unsigned int count = min(max, q->size);
+	unsigned int first = min(count, q->capacity - q->head);
+
+	memcpy(buffer, q->data + q->head, first * sizeof(void*));
+	memcpy(buffer + first, q->data, (count - first) * sizeof(void*));
+
+	q->head += count;
+	if (q->head >= q->capacity)
+		q->head -= q->capacity;
+	q->size -= count;
+
+	// Every freed slot may let a waiting producer in.
+	if (q->offerWaiters > 0)
+	{
+		if (count == 1)
+			pthread_cond_signal(&q->notFull);
+		else if (count > 1)
+			pthread_cond_broadcast(&q->notFull);
+	}
+
+	return count;
+}
+
+// Adds an item to the queue, waiting until the deadline for room.
+int bqueue_offerUntil(BlockingQueue* q, void* item, struct timespec* deadline)
+{
+	int offered = true;
+
+	pthread_mutex_lock(&q->lock);
+
+	while (q->size == q->capacity)
+	{
+		if (!bqueue_wait(q, &q->notFull, &q->offerWaiters, deadline))
+		{
+			offered = (q->size < q->capacity);
+			break;
+		}
+	}
+
+	if (offered)
+		bqueue_push(q, item);
+
+	pthread_mutex_unlock(&q->lock);
+
+	return offered;
+}
+
+// Removes up to max items from the queue, waiting until the deadline for
+// the first one.
+unsigned int bqueue_pollUntil(BlockingQueue* q, void** buffer, unsigned int max, struct timespec* deadline)
+{
+	unsigned int count;
+
+	pthread_mutex_lock(&q->lock);
+
+	while (q->size == 0)
+	{
+		if (!bqueue_wait(q, &q->notEmpty, &q->pollWaiters, deadline))
+			break;
+	}
+
+	count = bqueue_pop(q, buffer, max);
+
+	pthread_mutex_unlock(&q->lock);
+
+	return count;
+}
+
+// Returns an empty blocking queue allocated to the heap.
+BlockingQueue* newBlockingQueue(unsigned int capacity)
+{
+	BlockingQueue* q = alloc(BlockingQueue, 1);
+	pthread_condattr_t attr;
+
+	// Timeouts are measured on the monotonic clock so they aren't thrown
+	// off when the time of day is changed.
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+	pthread_mutex_init(&q->lock, NULL);
+	pthread_cond_init(&q->notEmpty, &attr);
+	pthread_cond_init(&q->notFull, &attr);
+	pthread_condattr_destroy(&attr);
+
+	q->pollWaiters = 0;
+	q->offerWaiters = 0;
+	q->capacity = (capacity == 0 ? 1 : capacity);
+	q->data = alloc(void*, q->capacity);
+	q->size = 0;
+	q->head = 0;
+	q->tail = 0;
+
+	return q;
+}
+
+// Adds an item to the end of the queue, waiting while it's full.
+void bqueue_offer(BlockingQueue* q, void* item)
+{
+	bqueue_offerUntil(q, item, NULL);
+}
+
+// Adds an item to the end of the queue, waiting a limited time while it's full.
+int bqueue_offerTimeout(BlockingQueue* q, void* item, unsigned int millis)
+{
+	struct timespec deadline = bqueue_deadline(millis);
+
+	return bqueue_offerUntil(q, item, &deadline);
+}
+
+// Removes and returns the item at the front of the queue, waiting while
+// it's empty.
+void* bqueue_poll(BlockingQueue* q)
+{
+	void* item = NULL;
+
+	bqueue_pollUntil(q, &item, 1, NULL);
+
+	return item;
+}
+
+// Removes and returns the item at the front of the queue, waiting a limited
+// time while it's empty.
+void* bqueue_pollTimeout(BlockingQueue* q, unsigned int millis)
+{
+	struct timespec deadline = bqueue_deadline(millis);
+	void* item = NULL;
+
+	bqueue_pollUntil(q, &item, 1, &deadline);
+
+	return item;
+}
+
+// Waits for an item and then removes as many items as are in the queue.
+unsigned int bqueue_drainTo(BlockingQueue* q, void** buffer, unsigned int max)
+{
+	if (max == 0)
+		return 0;
+
+	return bqueue_pollUntil(q, buffer, max, NULL);
+}
+
+// Returns the number of items in the queue.
+unsigned int bqueue_size(BlockingQueue* q)
+{
+	unsigned int size;
+
+	pthread_mutex_lock(&q->lock);
+	size = q->size;
+	pthread_mutex_unlock(&q->lock);
+
+	return size;
+}
+
+// Returns true if the queue has no items.
+int bqueue_isEmpty(BlockingQueue* q)
+{
+	return (bqueue_size(q) == 0);
+}
+
+// Removes the queue completely from memory.
+void bqueue_free(BlockingQueue* q)
+{
+	if (q == NULL)
+		return;
+
+	pthread_cond_destroy(&q->notFull);
+	pthread_cond_destroy(&q->notEmpty);
+	pthread_mutex_destroy(&q->lock);
+
+	free(q->data);
+	free(q);
+}
\ No newline at end of file
@@ -0,0 +1,602 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#include <string.h>
+
+#include "util.h"
+#include "clist.h"
+
+/**
+ * This is a chunk list containing generic data. The operations that can
+ * be performed on a chunk list are:
+ * 
+ * Get => Returns the item at an index in the list.
+ * Set => Sets the item at an index in the list.
+ * Add => Add an item to the end of the list.
+ * Insert => Insert an item into the list at some point.
+ * Remove => Remove an item from the list.
+ * RemoveAt => Remove an item at an index in the list.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Free => Frees the list from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+// Returns a new leaf with no items.
+ChunkListLeaf* clist_newLeaf()
+{
+	ChunkListLeaf* leaf = alloc(ChunkListLeaf, 1);
+	leaf->count = 0;
+	return leaf;
+}
+
+// Returns a new branch with no children.
+ChunkListBranch* clist_newBranch()
+{
+	ChunkListBranch* branch = alloc(ChunkListBranch, 1);
+	branch->count = 0;
+	return branch;
+}
+
+// Returns the number of items in the tree, which excludes the tail.
+unsigned int clist_treeSize(ChunkList* l)
+{
+	return l->size - l->tail->count;
+}
+
+// Returns the number of items under a node at the given height.
+unsigned int clist_nodeSize(void* node, unsigned int height)
+{
+	if (height == 0)
+		return ((ChunkListLeaf*)node)->count;
+
+	ChunkListBranch* b = (ChunkListBranch*)node;
+	unsigned int i, size = 0;
+
+	for (i = 0; i < b->count; i++)
+		size += b->sizes[i];
+
+	return size;
+}
+
+// Returns the number of children or items of a node at the given height.
+unsigned int clist_nodeCount(void* node, unsigned int height)
+{
+	if (height == 0)
+		return ((ChunkListLeaf*)node)->count;
+
+	return ((ChunkListBranch*)node)->count;
+}
+
+// Returns a pointer to the slot holding the item at the given index of the
+// tree by walking down through the branches.
+void** clist_locate(ChunkList* l, unsigned int index)
+{
+	void* node = l->root;
+	unsigned int h, c;
+
+	for (h = l->height; h > 0; h--)
+	{
+		ChunkListBranch* b = (ChunkListBranch*)node;
+
+		for (c = 0; index >= b->sizes[c]; c++)
+			index -= b->sizes[c];
+
+		node = b->children[c];
+	}
+
+	return &((ChunkListLeaf*)node)->items[index];
+}
+
+// Adds a child to a branch at the given position. If the branch is full it
+// is split and the new branch to its right is returned, otherwise NULL.
+ChunkListBranch* clist_addChild(ChunkListBranch* b, unsigned int position, void* child, unsigned int size)
+{
+	ChunkListBranch* right = NULL;
+
+	if (b->count == CLIST_BRANCH)
+	{
+		right = clist_newBranch();
+
+		// A child added past the end starts a new branch on its own so
+		// appending keeps branches full, otherwise split the branch in half.
+		if (position == CLIST_BRANCH)
+		{
+			right->children[0] = child;
+			right->sizes[0] = size;
+			right->count = 1;
+
+			return right;
+		}
+
+		unsigned int half = CLIST_BRANCH >> 1;
+
+		memcpy(right->children, b->children + half, half * sizeof(void*));
+		memcpy(right->sizes, b->sizes + half, half * sizeof(unsigned int));
+		right->count = half;
+		b->count = half;
+
+		if (position > half)
+		{
+			position -= half;
+			b = right;
+		}
+	}
+
+	memmove(b->children + position + 1, b->children + position, (b->count - position) * sizeof(void*));
+	memmove(b->sizes + position + 1, b->sizes + position, (b->count - position) * sizeof(unsigned int));
+	b->children[position] = child;
+	b->sizes[position] = size;
+	b->count++;
+
+	return right;
+}
+
+// Inserts an item into a node at the given height. If the node had to be
+// split the new node to its right is returned, otherwise NULL.
+void* clist_insertNode(void* node, unsigned int height, unsigned int index, void* item)
+{
+	if (height == 0)
+	{
+		ChunkListLeaf* leaf = (ChunkListLeaf*)node;
+		ChunkListLeaf* right = NULL;
+
+		// Split a full leaf in half and insert into the correct half.
+		if (leaf->count == CLIST_LEAF)
+		{
+			unsigned int half = CLIST_LEAF >> 1;
+
+			right = clist_newLeaf();
+			memcpy(right->items, leaf->items + half, half * sizeof(void*));
+			right->count = half;
+			leaf->count = half;
+
+			if (index > half)
+			{
+				index -= half;
+				leaf = right;
+			}
+		}
+
+		memmove(leaf->items + index + 1, leaf->items + index, (leaf->count - index) * sizeof(void*));
+		leaf->items[index] = item;
+		leaf->count++;
+
+		return right;
+	}
+
+	ChunkListBranch* b = (ChunkListBranch*)node;
+	unsigned int c = 0;
+
+	// Find the child holding the index, an index at the end of a child
+	// inserts at the end of that child.
+	while (c + 1 < b->count && index > b->sizes[c])
+		index -= b->sizes[c++];
+
+	void* split = clist_insertNode(b->children[c], height - 1, index, item);
+	b->sizes[c]++;
+
+	if (split == NULL)
+		return NULL;
+
+	unsigned int splitSize = clist_nodeSize(split, height - 1);
+	b->sizes[c] -= splitSize;
+
+	return clist_addChild(b, c + 1, split, splitSize);
+}
+
+// Appends a full leaf after the last leaf under a node at the given
+// height. If a new node had to be made to its right it's returned.
+void* clist_appendNode(void* node, unsigned int height, ChunkListLeaf* leaf)
+{
+	// A leaf can't hold other leaves, so the new leaf is its new neighbor.
+	if (height == 0)
+		return leaf;
+
+	ChunkListBranch* b = (ChunkListBranch*)node;
+
+	if (height == 1)
+		return clist_addChild(b, b->count, leaf, leaf->count);
+
+	unsigned int last = b->count - 1;
+	void* split = clist_appendNode(b->children[last], height - 1, leaf);
+
+	b->sizes[last] += leaf->count;
+
+	if (split == NULL)
+		return NULL;
+
+	unsigned int splitSize = clist_nodeSize(split, height - 1);
+	b->sizes[last] -= splitSize;
+
+	return clist_addChild(b, b->count, split, splitSize);
+}
+
+// Grows the tree by a level with the root and the node split from it.
+void clist_growRoot(ChunkList* l, void* split)
+{
+	ChunkListBranch* root = clist_newBranch();
+
+	root->children[0] = l->root;
+	root->sizes[0] = clist_nodeSize(l->root, l->height);
+	root->children[1] = split;
+	root->sizes[1] = clist_nodeSize(split, l->height);
+	root->count = 2;
+
+	l->root = root;
+	l->height++;
+}
+
+// Moves the full tail into the tree and starts a new empty tail.
+void clist_flushTail(ChunkList* l)
+{
+	if (l->root == NULL)
+	{
+		l->root = l->tail;
+		l->height = 0;
+	}
+	else
+	{
+		void* split = clist_appendNode(l->root, l->height, l->tail);
+
+		if (split != NULL)
+			clist_growRoot(l, split);
+	}
+
+	l->tail = clist_newLeaf();
+}
+
+// Merges the child of a branch with one of its neighbors if both fit in
+// one node, freeing the neighbor on the right.
+void clist_merge(ChunkListBranch* b, unsigned int c, unsigned int height)
+{
+	if (b->count < 2)
+		return;
+
+	unsigned int left = (c + 1 < b->count ? c : c - 1);
+	unsigned int right = left + 1;
+
+	if (height == 0)
+	{
+		ChunkListLeaf* a = (ChunkListLeaf*)b->children[left];
+		ChunkListLeaf* z = (ChunkListLeaf*)b->children[right];
+
+		if (a->count + z->count > CLIST_LEAF)
+			return;
+
+		memcpy(a->items + a->count, z->items, z->count * sizeof(void*));
+		a->count += z->count;
+		free(z);
+	}
+	else
+	{
+		ChunkListBranch* a = (ChunkListBranch*)b->children[left];
+		ChunkListBranch* z = (ChunkListBranch*)b->children[right];
+
+		if (a->count + z->count > CLIST_BRANCH)
+			return;
+
+		memcpy(a->children + a->count, z->children, z->count * sizeof(void*));
+		memcpy(a->sizes + a->count, z->sizes, z->count * sizeof(unsigned int));
+		a->count += z->count;
+		free(z);
+	}
+
+	b->sizes[left] += b->sizes[right];
+	b->count--;
+	memmove(b->children + right, b->children + right + 1, (b->count - right) * sizeof(void*));
+	memmove(b->sizes + right, b->sizes + right + 1, (b->count - right) * sizeof(unsigned int));
+}
+
+// Removes and returns the item at the given index under a node at the
+// given height, freeing or merging any children left too empty.
+void* clist_removeNode(void* node, unsigned int height, unsigned int index)
+{
+	if (height == 0)
+	{
+		ChunkListLeaf* leaf = (ChunkListLeaf*)node;
+		void* item = leaf->items[index];
+
+		leaf->count--;
+		memmove(leaf->items + index, leaf->items + index + 1, (leaf->count - index) * sizeof(void*));
+
+		return item;
+	}
+
+	ChunkListBranch* b = (ChunkListBranch*)node;
+	unsigned int c = 0;
+
+	while (index >= b->sizes[c])
+		index -= b->sizes[c++];
+
+	void* item = clist_removeNode(b->children[c], height - 1, index);
+	unsigned int count = clist_nodeCount(b->children[c], height - 1);
+
+	b->sizes[c]--;
+
+	// Drop an empty child, and merge a child that's under a quarter full.
+	if (count == 0)
+	{
+		free(b->children[c]);
+		b->count--;
+		memmove(b->children + c, b->children + c + 1, (b->count - c) * sizeof(void*));
+		memmove(b->sizes + c, b->sizes + c + 1, (b->count - c) * sizeof(unsigned int));
+	}
+	else if (count < (height == 1 ? CLIST_LEAF : CLIST_BRANCH) >> 2)
+	{
+		clist_merge(b, c, height - 1);
+	}
+
+	return item;
+}
+
+// Frees a node at the given height and everything under it.
+void clist_freeNode(void* node, unsigned int height)
+{
+	if (height > 0)
+	{
+		ChunkListBranch* b = (ChunkListBranch*)node;
+		unsigned int i;
+
+		for (i = 0; i < b->count; i++)
+			clist_freeNode(b->children[i], height - 1);
+	}
+
+	free(node);
+}
+
+// Traverses the items under a node at the given height in either direction.
+void clist_traverseNode(void* node, unsigned int height, void (*process)(void* item), int forward)
+{
+	unsigned int i;
+
+	if (height == 0)
+	{
+		ChunkListLeaf* leaf = (ChunkListLeaf*)node;
+
+		if (forward)
+			for (i = 0; i < leaf->count; i++)
+				process(leaf->items[i]);
+		else
+			for (i = leaf->count; i > 0; i--)
+				process(leaf->items[i - 1]);
+
+		return;
+	}
+
+	ChunkListBranch* b = (ChunkListBranch*)node;
+
+	if (forward)
+		for (i = 0; i < b->count; i++)
+			clist_traverseNode(b->children[i], height - 1, process, forward);
+	else
+		for (i = b->count; i > 0; i--)
+			clist_traverseNode(b->children[i - 1], height - 1, process, forward);
+}
+
+// Searches the items under a node for one equal to the given item, adding
+// the number of items passed over to the index. Returns true if found.
+int clist_findNode(void* node, unsigned int height, void* item, int (*equals)(void*, void*), unsigned int* index)
+{
+	unsigned int i;
+
+	if (height == 0)
+	{
+		ChunkListLeaf* leaf = (ChunkListLeaf*)node;
+
+		for (i = 0; i < leaf->count; i++, (*index)++)
+			if (equals(item, leaf->items[i]))
+				return true;
+
+		return false;
+	}
+
+	ChunkListBranch* b = (ChunkListBranch*)node;
+
+	for (i = 0; i < b->count; i++)
+		if (clist_findNode(b->children[i], height - 1, item, equals, index))
+			return true;
+
+	return false;
+}
+
+// Returns a new chunk list with no items, allocated to the heap.
+ChunkList* newChunkList()
+{
+	ChunkList* l = alloc(ChunkList, 1);
+
+	l->size = 0;
+	l->height = 0;
+	l->root = NULL;
+	l->tail = clist_newLeaf();
+
+	return l;
+}
+
+// Returns the i'th item in the chunk list.
+void* clist_get(ChunkList* l, unsigned int index)
+{
+	if (index >= l->size)
+		return NULL;
+
+	unsigned int treeSize = clist_treeSize(l);
+
+	if (index >= treeSize)
+		return l->tail->items[index - treeSize];
+
+	return *clist_locate(l, index);
+}
+
+// Sets the i'th item in the chunk list.
+int clist_set(ChunkList* l, unsigned int index, void* item)
+{
+	if (index >= l->size)
+		return false;
+
+	unsigned int treeSize = clist_treeSize(l);
+
+	if (index >= treeSize)
+		l->tail->items[index - treeSize] = item;
+	else
+		*clist_locate(l, index) = item;
+
+	return true;
+}
+
+// This will add an item to the end of the list.
+void clist_add(ChunkList* l, void* item)
+{
+	if (l->tail->count == CLIST_LEAF)
+		clist_flushTail(l);
+
+	l->tail->items[l->tail->count++] = item;
+	l->size++;
+}
+
+// Inserts data into a chunk list at the given index.
+int clist_insert(ChunkList* l, void* item, unsigned int index)
+{
+	if (index > l->size)
+		return false;
+
+	if (l->tail->count == CLIST_LEAF)
+		clist_flushTail(l);
+
+	unsigned int treeSize = clist_treeSize(l);
+
+	// Inserts at or after the start of the tail only shift the tail.
+	if (index >= treeSize)
+	{
+		ChunkListLeaf* tail = l->tail;
+		index -= treeSize;
+
+		memmove(tail->items + index + 1, tail->items + index, (tail->count - index) * sizeof(void*));
+		tail->items[index] = item;
+		tail->count++;
+	}
+	else
+	{
+		void* split = clist_insertNode(l->root, l->height, index, item);
+
+		if (split != NULL)
+			clist_growRoot(l, split);
+	}
+
+	l->size++;
+
+	return true;
+}
+
+// Removes the first item from the list that equals the given item.
+void* clist_remove(ChunkList* l, void* item, int (*equals)(void*, void*))
+{
+	unsigned int i, index = 0;
+
+	if (l->root != NULL && clist_findNode(l->root, l->height, item, equals, &index))
+		return clist_removeAt(l, index);
+
+	for (i = 0; i < l->tail->count; i++)
+		if (equals(item, l->tail->items[i]))
+			return clist_removeAt(l, index + i);
+
+	return NULL;
+}
+
+// Removes and returns the item at the given index.
+void* clist_removeAt(ChunkList* l, unsigned int index)
+{
+	if (index >= l->size)
+		return NULL;
+
+	unsigned int treeSize = clist_treeSize(l);
+	void* item;
+
+	l->size--;
+
+	if (index >= treeSize)
+	{
+		ChunkListLeaf* tail = l->tail;
+		index -= treeSize;
+		item = tail->items[index];
+
+		tail->count--;
+		memmove(tail->items + index, tail->items + index + 1, (tail->count - index) * sizeof(void*));
+
+		return item;
+	}
+
+	item = clist_removeNode(l->root, l->height, index);
+
+	// Shrink the tree while the root has a single child, and drop the
+	// root once it's empty.
+	while (l->height > 0 && ((ChunkListBranch*)l->root)->count == 1)
+	{
+		void* child = ((ChunkListBranch*)l->root)->children[0];
+		free(l->root);
+		l->root = child;
+		l->height--;
+	}
+
+	if (clist_nodeCount(l->root, l->height) == 0)
+	{
+		free(l->root);
+		l->root = NULL;
+		l->height = 0;
+	}
+
+	return item;
+}
+
+// Returns true if the chunk list has no items in it.
+int clist_isEmpty(ChunkList* l)
+{
+	return (l->size == 0);
+}
+
+// Traverses the list from front to back.
+void clist_traverseForward(ChunkList* l, void (*process)(void* item))
+{
+	if (l->root != NULL)
+		clist_traverseNode(l->root, l->height, process, true);
+
+	clist_traverseNode(l->tail, 0, process, true);
+}
+
+// Traverses the list from back to front.
+void clist_traverseBackward(ChunkList* l, void (*process)(void* item))
+{
+	clist_traverseNode(l->tail, 0, process, false);
+
+	if (l->root != NULL)
+		clist_traverseNode(l->root, l->height, process, false);
+}
+
+// Clears the list of all data, freeing every chunk but the tail.
+void clist_clear(ChunkList* l)
+{
+	if (l->root != NULL)
+		clist_freeNode(l->root, l->height);
+
+	l->root = NULL;
+	l->height = 0;
+	l->tail->count = 0;
+	l->size = 0;
+}
+
+// Removes the list completely from memory.
+void clist_free(ChunkList* l)
+{
+	if (l == NULL)
+		return;
+
+	clist_clear(l);
+	free(l->tail);
+	free(l);
+}
\ No newline at end of file
@@ -0,0 +1,248 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * A ring of preallocated events which one producer writes and any number
+ * of consumers read. The operations that can be performed on a disruptor
+ * are:
+ * 
+ * AddConsumer => Adds a consumer, optionally behind other consumers.
+ * Claim => Reserves slots for the producer to write events into.
+ * Get => Returns the slot of an event by its sequence.
+ * Publish => Makes the claimed events readable by consumers.
+ * WaitFor => Waits until a consumer has events to read.
+ * Available => Returns the number of events a consumer can read.
+ * Release => Marks events as read by a consumer.
+ * Consume => Reads and releases every event available to a consumer.
+ * Free => Frees the disruptor and its consumers from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+#include <string.h>
+#include <sched.h>
+
+#include "util.h"
+#include "disruptor.h"
+
+// The number of times a waiting thread checks again before yielding.
+#define DISRUPTOR_SPINS	64
+
+// Waits a moment before a thread checks again, yielding after spinning.
+void disruptor_pause(unsigned int* spins)
+{
+	if (*spins < DISRUPTOR_SPINS)
+		(*spins)++;
+	else
+		sched_yield();
+}
+
+// Returns the lowest sequence of every consumer, or the claimed sequence
+// if there are no consumers.
+unsigned long long disruptor_minimum(Disruptor* d)
+{
+	unsigned long long minimum = d->claimed;
+	unsigned long long sequence;
+	unsigned int i;
+
+	for (i = 0; i < d->consumerCount; i++)
+	{
+		sequence = atomic_load_explicit(&d->consumers[i]->sequence, memory_order_acquire);
+		minimum = min(minimum, sequence);
+	}
+
+	return minimum;
+}
+
+// Returns true if the next count slots are free, checking the consumers
+// again only when the last seen gate doesn't leave enough room.
+int disruptor_hasRoom(Disruptor* d, unsigned int count)
+{
+	if (d->claimed + count - d->gate <= d->capacity)
+		return true;
+
+	d->gate = disruptor_minimum(d);
+
+	return (d->claimed + count - d->gate <= d->capacity);
+}
+
+// Returns an empty disruptor allocated to the heap.
+Disruptor* newDisruptor(unsigned int capacity, unsigned int eventSize)
+{
+	Disruptor* d;
+
+	if (posix_memalign((void**)&d, CACHE_LINE, sizeof(Disruptor)) != 0)
+		return NULL;
+
+	// Determine the next size thats a power of 2
+	unsigned int actual = 1;
+	while (actual < capacity)
+		actual <<= 1;
+
+	atomic_init(&d->published, 0);
+	d->claimed = 0;
+	d->gate = 0;
+	d->capacity = actual;
+	d->mask = actual - 1;
+	d->eventSize = max(1, eventSize);
+	d->slots = calloc(char, (size_t)actual * d->eventSize);
+	d->consumers = NULL;
+	d->consumerCount = 0;
+
+	return d;
+}
+
+// Adds a consumer which reads every event published after it's added.
+DisruptorConsumer* disruptor_addConsumer(Disruptor* d, DisruptorConsumer** dependencies, unsigned int dependencyCount)
+{
+	DisruptorConsumer* c;
+
+	if (posix_memalign((void**)&c, CACHE_LINE, sizeof(DisruptorConsumer)) != 0)
+		return NULL;
+
+	unsigned long long start = atomic_load_explicit(&d->published, memory_order_relaxed);
+
+	atomic_init(&c->sequence, start);
+	c->available = start;
+	c->disruptor = d;
+	c->dependencyCount = (dependencies == NULL ? 0 : dependencyCount);
+	c->dependencies = NULL;
+
+	if (c->dependencyCount > 0)
+	{
+		c->dependencies = alloc(DisruptorConsumer*, dependencyCount);
+		memcpy(c->dependencies, dependencies, dependencyCount * sizeof(DisruptorConsumer*));
+	}
+
+	d->consumers = realloc(d->consumers, DisruptorConsumer*, d->consumerCount + 1);
+	d->consumers[d->consumerCount++] = c;
+
+	return c;
+}
+
+// Reserves the next count slots for the producer, waiting until they're free.
+unsigned long long disruptor_claim(Disruptor* d, unsigned int count)
+{
+	unsigned long long sequence;
+	unsigned int spins = 0;
+
+	while (!disruptor_tryClaim(d, count, &sequence))
+		disruptor_pause(&spins);
+
+	return sequence;
+}
+
+// Reserves the next count slots for the producer if they're free.
+int disruptor_tryClaim(Disruptor* d, unsigned int count, unsigned long long* sequence)
+{
+	if (count > d->capacity || !disruptor_hasRoom(d, count))
+		return false;
+
+	*sequence = d->claimed;
+	d->claimed += count;
+
+	return true;
+}
+
+// Returns the slot of the event with the given sequence.
+void* disruptor_get(Disruptor* d, unsigned long long sequence)
+{
+	return d->slots + (size_t)(sequence & d->mask) * d->eventSize;
+}
+
+// Makes the next count claimed events readable by the consumers.
+void disruptor_publish(Disruptor* d, unsigned int count)
+{
+	unsigned long long published = atomic_load_explicit(&d->published, memory_order_relaxed);
+
+	// The events written to the slots are visible before the new sequence.
+	atomic_store_explicit(&d->published, published + count, memory_order_release);
+}
+
+// Returns how many events the consumer can read without waiting.
+unsigned int disruptor_available(DisruptorConsumer* c)
+{
+	unsigned long long sequence = atomic_load_explicit(&c->sequence, memory_order_relaxed);
+	unsigned long long bound;
+	unsigned int i;
+
+	// Only look at the other cursors again once the known events are read.
+	if (c->available > sequence)
+		return (unsigned int)(c->available - sequence);
+
+	bound = atomic_load_explicit(&c->disruptor->published, memory_order_acquire);
+
+	for (i = 0; i < c->dependencyCount; i++)
+	{
+		unsigned long long dependency = atomic_load_explicit(&c->dependencies[i]->sequence, memory_order_acquire);
+		bound = min(bound, dependency);
+	}
+
+	c->available = bound;
+
+	return (unsigned int)(bound - sequence);
+}
+
+// Waits until the consumer has events to read.
+unsigned int disruptor_waitFor(DisruptorConsumer* c)
+{
+	unsigned int available;
+	unsigned int spins = 0;
+
+	while ((available = disruptor_available(c)) == 0)
+		disruptor_pause(&spins);
+
+	return available;
+}
+
+// Marks the next count events as read by the consumer.
+void disruptor_release(DisruptorConsumer* c, unsigned int count)
+{
+	unsigned long long sequence = atomic_load_explicit(&c->sequence, memory_order_relaxed);
+
+	// The reads of the slots happen before the producer can reuse them.
+	atomic_store_explicit(&c->sequence, sequence + count, memory_order_release);
+}
+
+// Reads and releases every event available to the consumer.
+unsigned int disruptor_consume(DisruptorConsumer* c,
+	void (*handler)(void* event, unsigned long long sequence, void* arg), void* arg)
+{
+	Disruptor* d = c->disruptor;
+	unsigned int available = disruptor_waitFor(c);
+	unsigned long long sequence = atomic_load_explicit(&c->sequence, memory_order_relaxed);
+	unsigned long long end = sequence + available;
+	unsigned long long i;
+
+	for (i = sequence; i < end; i++)
+		handler(disruptor_get(d, i), i, arg);
+
+	disruptor_release(c, available);
+
+	return available;
+}
+
+// Removes the disruptor and its consumers completely from memory.
+void disruptor_free(Disruptor* d)
+{
+	if (d == NULL)
+		return;
+
+	unsigned int i;
+
+	for (i = 0; i < d->consumerCount; i++)
+	{
+		free(d->consumers[i]->dependencies);
+		free(d->consumers[i]);
+	}
+
+	free(d->consumers);
+	free(d->slots);
+	free(d);
+}
\ No newline at end of file
@@ -5,6 +5,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
 
 #include "list.h"
 #include "stack.h"
@@ -16,6 +21,26 @@
 #include "maxheap.h"
 #include "minheap.h"
 #include "alist.h"
+#include "timerwheel.h"
+#include "radixheap.h"
+#include "pairingheap.h"
+#include "leftistheap.h"
+#include "talist.h"
+#include "salist.h"
+#include "glist.h"
+#include "clist.h"
+#include "ulist.h"
+#include "ilist.h"
+#include "spscqueue.h"
+#include "mpmcqueue.h"
+#include "wsdeque.h"
+#include "bqueue.h"
+#include "scheduler.h"
+#include "parallel.h"
+#include "adeque.h"
+#include "mlqueue.h"
+#include "disruptor.h"
+#include "sstack.h"
 
 // Runs the example on how to use the linked-list data structure
 void exampleList();
@@ -37,6 +62,54 @@ void exampleMaxHeap();
 void exampleMinHeap();
 // Runs the example on how to use the array list data structure
 void exampleArrayList();
+// Runs the example on how to use the timer wheel data structure
+void exampleTimerWheel();
+// Runs the example on how to use the radix heap data structure
+void exampleRadixHeap();
+// Runs the example on how to use the pairing heap data structure
+void examplePairingHeap();
+// Runs the example on how to use the minimum heap to keep the highest keys
+void exampleMinHeapTopK();
+// Runs the example on how to use the leftist heap data structure
+void exampleLeftistHeap();
+// Runs the example on how to use the minimum heap to merge and drain heaps
+void exampleMinHeapMerge();
+// Runs the example on how to use the typed array list data structure
+void exampleTypedArrayList();
+// Runs the example on how to use the array list to add and remove many items at once
+void exampleArrayListBulk();
+// Runs the example on how to use the array list to sort and search items
+void exampleArrayListSort();
+// Runs the example on how to use the small array list data structure
+void exampleSmallArrayList();
+// Runs the example on how to use the gap list data structure
+void exampleGapList();
+// Runs the example on how to use the chunk list data structure
+void exampleChunkList();
+// Runs the example on how to use the unrolled list data structure
+void exampleUnrolledList();
+// Runs the example on how to use the intrusive list, queue and stack
+void exampleIntrusiveList();
+// Runs the example on how to use the single producer single consumer queue
+void exampleSpscQueue();
+// Runs the example on how to use the multi producer multi consumer queue
+void exampleMpmcQueue();
+// Runs the example on how to use the work-stealing deque
+void exampleWorkStealingDeque();
+// Runs the example on how to use the blocking queue
+void exampleBlockingQueue();
+// Runs the example on how to use the fork-join scheduler and parallel loops
+void exampleScheduler();
+// Runs the example on how to use the array queue and deque segments
+void exampleArrayQueueSegments();
+// Runs the example on how to use the array deque data structure
+void exampleArrayDeque();
+// Runs the example on how to use the multi-level queue
+void exampleMultiLevelQueue();
+// Runs the example on how to use the disruptor ring
+void exampleDisruptor();
+// Runs the example on how to use the segmented stack data structure
+void exampleSegmentedStack();
 
 int main(int argc, char* argv[])
 {
@@ -71,6 +144,78 @@ int main(int argc, char* argv[])
 	printf("\nARRAY LIST EXAMPLE\n\n");
 	exampleArrayList();
 
+	printf("\nTIMER WHEEL EXAMPLE\n\n");
+	exampleTimerWheel();
+
+	printf("\nRADIX HEAP EXAMPLE\n\n");
+	exampleRadixHeap();
+
+	printf("\nPAIRING HEAP EXAMPLE\n\n");
+	examplePairingHeap();
+
+	printf("\nMIN HEAP TOP K EXAMPLE\n\n");
+	exampleMinHeapTopK();
+
+	printf("\nLEFTIST HEAP EXAMPLE\n\n");
+	exampleLeftistHeap();
+
+	printf("\nMIN HEAP MERGE EXAMPLE\n\n");
+	exampleMinHeapMerge();
+
+	printf("\nTYPED ARRAY LIST EXAMPLE\n\n");
+	exampleTypedArrayList();
+
+	printf("\nARRAY LIST BULK EXAMPLE\n\n");
+	exampleArrayListBulk();
+
+	printf("\nARRAY LIST SORT EXAMPLE\n\n");
+	exampleArrayListSort();
+
+	printf("\nSMALL ARRAY LIST EXAMPLE\n\n");
+	exampleSmallArrayList();
+
+	printf("\nGAP LIST EXAMPLE\n\n");
+	exampleGapList();
+
+	printf("\nCHUNK LIST EXAMPLE\n\n");
+	exampleChunkList();
+
+	printf("\nUNROLLED LIST EXAMPLE\n\n");
+	exampleUnrolledList();
+
+	printf("\nINTRUSIVE LIST EXAMPLE\n\n");
+	exampleIntrusiveList();
+
+	printf("\nSPSC QUEUE EXAMPLE\n\n");
+	exampleSpscQueue();
+
+	printf("\nMPMC QUEUE EXAMPLE\n\n");
+	exampleMpmcQueue();
+
+	printf("\nWORK STEALING DEQUE EXAMPLE\n\n");
+	exampleWorkStealingDeque();
+
+	printf("\nBLOCKING QUEUE EXAMPLE\n\n");
+	exampleBlockingQueue();
+
+	printf("\nSCHEDULER EXAMPLE\n\n");
+	exampleScheduler();
+
+	printf("\nARRAY QUEUE SEGMENTS EXAMPLE\n\n");
+	exampleArrayQueueSegments();
+
+	printf("\nARRAY DEQUE EXAMPLE\n\n");
+	exampleArrayDeque();
+
+	printf("\nMULTI LEVEL QUEUE EXAMPLE\n\n");
+	exampleMultiLevelQueue();
+
+	printf("\nDISRUPTOR EXAMPLE\n\n");
+	exampleDisruptor();
+
+	printf("\nSEGMENTED STACK EXAMPLE\n\n");
+	exampleSegmentedStack();
+
 	return 0;
 }
 
@@ -805,3 +950,1913 @@ void exampleArrayList()
 
 	alist_free(l);
 }
+
+void advanceWheel(TimerWheel* w, unsigned int ticks)
+{
+	printf("Advance %u: ", ticks);
+	unsigned int expired = timerwheel_advance(w, ticks, &process);
+	printf(" (%u expired, now at tick %u)\n", expired, w->now);
+}
+
+void exampleTimerWheel()
+{
+	// Use pooling for efficiency, if you don't want to use pooling
+	// then comment out this line.
+	pool_timerwheel(16);
+
+	TimerWheel* W = newTimerWheel();
+
+	// A timer on the lowest level, one that cascades down from the second
+	// level and one that cascades down from the third level.
+	timerwheel_schedule(W, 5, "A");
+	timerwheel_schedule(W, 300, "B");
+	timerwheel_schedule(W, 70000, "C");
+	TimerNode* D = timerwheel_schedule(W, 10, "D");
+
+	// Cancel a timer before it expires
+	printf("Cancelled: %s\n", (char*)timerwheel_cancel(W, D));
+
+	// Each timer expires on exactly the tick it was scheduled for
+	advanceWheel(W, 4);
+	advanceWheel(W, 1);
+	advanceWheel(W, 294);
+	advanceWheel(W, 1);
+	advanceWheel(W, 69699);
+	advanceWheel(W, 1);
+
+	if (timerwheel_isEmpty(W))
+		printf("All timers expired.\n");
+
+	// With nothing scheduled the wheel skips ahead, here to just before
+	// the tick count wraps around to zero.
+	timerwheel_advance(W, UINT_MAX - 2 - W->now, &process);
+	printf("Now at tick %u\n", W->now);
+
+	// Timers that expire after the wrap still expire on time
+	timerwheel_schedule(W, 2, "E");
+	timerwheel_schedule(W, 5, "F");
+	timerwheel_schedule(W, 600, "G");
+
+	advanceWheel(W, 2);
+	advanceWheel(W, 3);
+	advanceWheel(W, 594);
+	advanceWheel(W, 1);
+
+	// Clear any timers left without expiring them
+	timerwheel_schedule(W, 1000, "H");
+	timerwheel_clear(W);
+	if (timerwheel_isEmpty(W))
+		printf("Timer wheel cleared.\n");
+
+	timerwheel_free(W);
+
+	// If you're not using pooling this can be commented out. This will
+	// free all pooled nodes from memory. Always call this at the end
+	// of using any TimerWheel.
+	unpool_timerwheel();
+}
+
+void exampleRadixHeap()
+{
+	RadixHeap* H = newRadixHeap();
+
+	radixheap_add(H, 40, "40");
+	radixheap_add(H, 7, "7");
+	radixheap_add(H, 1000000, "1000000");
+	radixheap_add(H, 12, "12");
+	radixheap_add(H, 7, "7");
+
+	printf("Peek: '%s'\n", (char*)radixheap_peekMin(H));
+	printf("Pop: '%s'\n", (char*)radixheap_popMin(H));
+	printf("Pop: '%s'\n", (char*)radixheap_popMin(H));
+
+	// Keys can't be smaller then the last key popped, like the distances
+	// found in a shortest path search.
+	if (!radixheap_add(H, 3, "3"))
+		printf("Cannot add 3, the last key popped was %u.\n", H->last);
+
+	radixheap_add(H, 7, "7");
+	radixheap_add(H, 41, "41");
+	radixheap_add(H, 4000000000u, "4000000000");
+
+	printf("Popping.. ");
+	while (!radixheap_isEmpty(H))
+		printf("%s ", (char*)radixheap_popMin(H));
+	printf("\n");
+
+	// Clearing the heap lets any key be added again
+	radixheap_clear(H);
+	if (radixheap_add(H, 3, "3"))
+		printf("Cleared. Added '%s'\n", (char*)radixheap_peekMin(H));
+
+	radixheap_free(H);
+}
+
+void examplePairingHeap()
+{
+	// Use pooling for efficiency, if you don't want to use pooling
+	// then comment out this line.
+	pool_pairingheap(32);
+
+	PairingHeap* H = newPairingHeap();
+
+	pairingheap_add(H, 99, "99");
+	pairingheap_add(H, 45, "45");
+	pairingheap_add(H, 57, "57");
+	pairingheap_add(H, 12, "12");
+
+	// Keep the nodes to change or remove them later
+	PairingHeapNode* a = pairingheap_addNode(H, 87, "87");
+	PairingHeapNode* b = pairingheap_addNode(H, 42, "42");
+
+	printf("Pop: '%s'\n", (char*)pairingheap_popMin(H));
+
+	printf("Decrease 87 to 1\n");
+	pairingheap_decreaseKey(H, a, 1);
+	printf("Peek: '%s'\n", (char*)pairingheap_peekMin(H));
+
+	printf("Remove: '%s'\n", (char*)pairingheap_removeNode(H, b));
+
+	if (!pairingheap_decreaseKey(H, a, 50))
+		printf("Cannot decrease the key 1 to 50.\n");
+
+	printf("Update 57 to 3\n");
+	pairingheap_update(H, 57, 3);
+
+	// Meld another heap into this one, which leaves the other heap empty
+	PairingHeap* O = newPairingHeap();
+	pairingheap_add(O, 2, "2");
+	pairingheap_add(O, 60, "60");
+	pairingheap_meld(H, O);
+
+	if (pairingheap_isEmpty(O))
+		printf("Melded.\n");
+
+	printf("Popping.. ");
+	while (!pairingheap_isEmpty(H))
+		printf("%s ", (char*)pairingheap_popMin(H));
+	printf("\n");
+
+	pairingheap_free(O);
+	pairingheap_free(H);
+
+	// If you're not using pooling this can be commented out. This will
+	// free all pooled nodes from memory. Always call this at the end
+	// of using any PairingHeap.
+	unpool_pairingheap();
+}
+
+void exampleMinHeapTopK()
+{
+	// A heap that's full keeps the 5 highest keys offered to it
+	MinHeap* H = newMinHeap(5);
+
+	int total = 21;
+	int keys[] = {0, 23, 3, 6, 41, 17, 21, 8, 9, 68, 2, 1, 34, 29, 38, 11, 15, 16, 45, 65, 39};
+	char* items[] = {"0", "23", "3", "6", "41", "17", "21", "8", "9", "68", "2", "1", "34", "29", "38", "11", "15", "16", "45", "65", "39"};
+	int rejected = 0;
+	int i;
+
+	for (i = 0; i < total; i++)
+		if (!minheap_offer(H, keys[i], items[i]))
+			rejected++;
+
+	printf("Offered %d, rejected %d\n", total, rejected);
+	minheap_display(H, 2, &toString);
+
+	// Sort the heap in place, which is still a valid min heap
+	minheap_sort(H);
+	printf("Sorted: ");
+	for (i = 0; i < H->size; i++)
+		printf("%s ", (char*)H->nodes[i]->data);
+	printf("\n");
+
+	// Replace the lowest key with one that's higher
+	printf("Replaced: '%s' with '99'\n", (char*)minheap_replaceMin(H, 99, "99"));
+	printf("Peek: '%s'\n", (char*)minheap_peekMin(H));
+
+	printf("Popping.. ");
+	while (!minheap_isEmpty(H))
+		printf("%s ", (char*)minheap_popMin(H));
+	printf("\n");
+
+	// Replacing on an empty heap just adds the item
+	if (minheap_replaceMin(H, 7, "7") == NULL)
+		printf("Added '%s' to the empty heap\n", (char*)minheap_peekMin(H));
+
+	minheap_free(H);
+}
+
+void exampleLeftistHeap()
+{
+	// Use pooling for efficiency, if you don't want to use pooling
+	// then comment out this line.
+	pool_leftistheap(32);
+
+	LeftistHeap* A = newLeftistHeap();
+	LeftistHeap* B = newLeftistHeap();
+
+	leftistheap_add(A, 99, "99");
+	leftistheap_add(A, 45, "45");
+	leftistheap_add(A, 57, "57");
+	leftistheap_add(A, 12, "12");
+
+	leftistheap_add(B, 87, "87");
+	leftistheap_add(B, 42, "42");
+	leftistheap_add(B, 3, "3");
+
+	printf("Peek A: '%s'\n", (char*)leftistheap_peekMin(A));
+	printf("Peek B: '%s'\n", (char*)leftistheap_peekMin(B));
+
+	// Meld B into A, which leaves B empty
+	leftistheap_meld(A, B);
+	printf("Melded. A has %u items\n", A->size);
+
+	if (leftistheap_isEmpty(B))
+		printf("B is empty.\n");
+
+	printf("Popping.. ");
+	while (!leftistheap_isEmpty(A))
+		printf("%s ", (char*)leftistheap_popMin(A));
+	printf("\n");
+
+	leftistheap_free(A);
+	leftistheap_free(B);
+
+	// If you're not using pooling this can be commented out. This will
+	// free all pooled nodes from memory. Always call this at the end
+	// of using any LeftistHeap.
+	unpool_leftistheap();
+}
+
+void processWord(void* item)
+{
+	printf("%s ", (char*)item);
+}
+
+void exampleMinHeapMerge()
+{
+	MinHeap* A = newMinHeap(4);
+	MinHeap* B = newMinHeap(4);
+	MinHeap* C = newMinHeap(4);
+
+	minheap_add(A, 99, "99");
+	minheap_add(A, 45, "45");
+	minheap_add(A, 57, "57");
+
+	minheap_add(B, 12, "12");
+	minheap_add(B, 87, "87");
+	minheap_add(B, 42, "42");
+	minheap_add(B, 67, "67");
+
+	// Merge B into A, A grows to fit all of the items
+	minheap_merge(A, B);
+	printf("Merged. A has %u items, B has %u items\n", A->size, B->size);
+	minheap_display(A, 2, &toString);
+
+	// Drain several heaps at once in order of key
+	minheap_add(B, 50, "50");
+	minheap_add(B, 1, "1");
+	minheap_add(C, 70, "70");
+	minheap_add(C, 5, "5");
+	minheap_add(C, 44, "44");
+
+	MinHeap* heaps[] = {A, B, C};
+
+	printf("Draining.. ");
+	minheap_drainSorted(heaps, 3, &processWord);
+	printf("\n");
+
+	if (minheap_isEmpty(A) && minheap_isEmpty(B) && minheap_isEmpty(C))
+		printf("All heaps drained.\n");
+
+	minheap_free(A);
+	minheap_free(B);
+	minheap_free(C);
+}
+
+// A typed array list of a type the library doesn't define
+typedef struct
+{
+	int x, y;
+
+} Pair;
+
+ALIST_DECLARE(Pair)
+ALIST_DEFINE(Pair)
+
+void printInt(int* item)
+{
+	printf("%d ", *item);
+}
+
+int equalsInt(int* a, int* b)
+{
+	return (*a == *b);
+}
+
+void exampleTypedArrayList()
+{
+	// Items are stored by value, so no pointers to integers are needed
+	ArrayList_int* l = newArrayList_int(4);
+
+	int x;
+	for (x = 1; x <= 10; x++)
+		alist_int_add(l, x * x);
+
+	printf("Size: %u, Capacity: %u\n", l->size, l->capacity);
+	alist_int_traverseForward(l, &printInt);
+	printf("\n");
+
+	printf("Remove 49 and the item at 0\n");
+	alist_int_remove(l, 49, &equalsInt);
+	alist_int_removeAt(l, 0, NULL);
+	alist_int_traverseForward(l, &printInt);
+	printf("\n");
+
+	printf("Insert 0 at 0 and set 3 to -1\n");
+	alist_int_insert(l, 0, 0);
+	alist_int_set(l, 3, -1);
+	alist_int_traverseBackward(l, &printInt);
+	printf("\n");
+
+	// Pointers to items can be used to change them in place
+	*alist_int_at(l, 1) += 1000;
+	printf("1: %d\n", alist_int_get(l, 1));
+
+	// Items out of bounds are zeroed
+	printf("100: %d\n", alist_int_get(l, 100));
+
+	// Shrinking the list drops the items past the new capacity
+	alist_int_resize(l, 3);
+	printf("Resized. Size: %u, Capacity: %u\n", l->size, l->capacity);
+	alist_int_traverseForward(l, &printInt);
+	printf("\n");
+
+	// Resizing to zero still leaves room for one item
+	alist_int_clear(l);
+	alist_int_resize(l, 0);
+	alist_int_add(l, 42);
+	printf("Resized to 0 and added %d. Capacity: %u\n", alist_int_get(l, 0), l->capacity);
+
+	alist_int_free(l);
+
+	// A list of structures
+	ArrayList_Pair* p = newArrayList_Pair(2);
+	Pair a = {1, 2};
+	Pair b = {3, 4};
+	alist_Pair_add(p, a);
+	alist_Pair_add(p, b);
+	alist_Pair_add(p, a);
+
+	unsigned int i;
+	for (i = 0; i < p->size; i++)
+		printf("(%d, %d) ", p->data[i].x, p->data[i].y);
+	printf("\n");
+
+	alist_Pair_free(p);
+}
+
+int startsWithE(void* item)
+{
+	return (((char*)item)[0] == 'E');
+}
+
+void exampleArrayListBulk()
+{
+	ArrayList* l = newArrayList(2);
+
+	// Add several items growing the list at most once
+	char* first[] = {"Aye", "Bee", "Eee", "Eff", "Gee"};
+	alist_addAll(l, (void**)first, 5);
+	alist_traverseForward(l, &processWord);
+	printf("(capacity %u)\n", l->capacity);
+
+	// Insert several items in the middle shifting the rest once
+	char* middle[] = {"Sea", "Dee"};
+	printf("Insert 'Sea' and 'Dee' at 2\n");
+	alist_insertRange(l, (void**)middle, 2, 2);
+	alist_traverseForward(l, &processWord);
+	printf("\n");
+
+	// Inserting past the end of the list does nothing
+	if (!alist_insertRange(l, (void**)middle, 2, l->size + 1))
+		printf("Cannot insert past the end of the list.\n");
+
+	printf("Remove from 1 up to 3: %u removed\n", alist_removeRange(l, 1, 3));
+	alist_traverseForward(l, &processWord);
+	printf("\n");
+
+	// The range is cut off at the end of the list
+	alist_addAll(l, (void**)first, 5);
+	printf("Remove from 5 up to 100: %u removed\n", alist_removeRange(l, 5, 100));
+	alist_traverseForward(l, &processWord);
+	printf("\n");
+
+	alist_addAll(l, (void**)first, 5);
+	printf("Remove all starting with 'E': %u removed\n", alist_removeIf(l, &startsWithE));
+	alist_traverseForward(l, &processWord);
+	printf("\n");
+
+	alist_free(l);
+}
+
+int compareInt(void* a, void* b)
+{
+	int x = *((int*)a);
+	int y = *((int*)b);
+
+	return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+int keyInt(void* item)
+{
+	return *((int*)item);
+}
+
+int compareFirstLetter(void* a, void* b)
+{
+	return ((char*)a)[0] - ((char*)b)[0];
+}
+
+int isSorted(ArrayList* l)
+{
+	unsigned int i;
+	for (i = 1; i < l->size; i++)
+		if (compareInt(alist_get(l, i - 1), alist_get(l, i)) > 0)
+			return 0;
+
+	return 1;
+}
+
+void exampleArrayListSort()
+{
+	int nums[] = {5, -3, 12, 0, -40, 7, 7, 2147483647, -2147483647 - 1, 1};
+	int total = 10;
+	ArrayList* l = newArrayList(16);
+	int x;
+
+	for (x = 0; x < total; x++)
+		alist_add(l, &nums[x]);
+
+	alist_sort(l, &compareInt);
+	printf("Sort: ");
+	for (x = 0; x < l->size; x++)
+		printf("%d ", *((int*)alist_get(l, x)));
+	printf("\n");
+
+	// Search for an item that exists and one that doesn't
+	int find = 7;
+	printf("Index of 7: %d\n", alist_binarySearch(l, &find, &compareInt));
+	find = 3;
+	printf("Index of 3: %d (insert at %d)\n", alist_binarySearch(l, &find, &compareInt),
+		-alist_binarySearch(l, &find, &compareInt) - 1);
+
+	// Sorting by key puts negative keys before positive ones
+	alist_clear(l);
+	for (x = total - 1; x >= 0; x--)
+		alist_add(l, &nums[x]);
+
+	alist_sortByKey(l, &keyInt);
+	printf("Sort by key: ");
+	for (x = 0; x < l->size; x++)
+		printf("%d ", *((int*)alist_get(l, x)));
+	printf("\n");
+
+	// A large list in a pattern that is slow for a plain quicksort
+	int* big = malloc(sizeof(int) * 10000);
+	alist_clear(l);
+	for (x = 0; x < 10000; x++)
+	{
+		big[x] = (x < 5000 ? x : 10000 - x);
+		alist_add(l, &big[x]);
+	}
+
+	alist_sort(l, &compareInt);
+	if (isSorted(l))
+		printf("10000 items sorted.\n");
+
+	// Scramble the items again, with half of them negative
+	for (x = 0; x < 10000; x++)
+		big[x] = (x * 7919) % 10000 - 5000;
+
+	alist_parallelSort(l, &compareInt, 4);
+	if (isSorted(l))
+		printf("10000 items sorted on 4 threads.\n");
+
+	alist_sortByKey(l, &keyInt);
+	if (isSorted(l))
+		printf("10000 items sorted by key.\n");
+
+	free(big);
+
+	// A stable sort keeps items that compare equal in the order they were added
+	alist_clear(l);
+	alist_add(l, "Bob");
+	alist_add(l, "Ann");
+	alist_add(l, "Bea");
+	alist_add(l, "Cal");
+	alist_add(l, "Amy");
+	alist_add(l, "Ben");
+
+	alist_stableSort(l, &compareFirstLetter);
+	printf("Stable sort by first letter: ");
+	alist_traverseForward(l, &processWord);
+	printf("\n");
+
+	alist_free(l);
+}
+
+void exampleSmallArrayList()
+{
+	// A list on the stack doesn't allocate until it holds too many items
+	SmallArrayList l;
+	salist_init(&l);
+
+	char* letters[] = {"A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K"};
+	int x;
+	for (x = 0; x < SALIST_INLINE; x++)
+		salist_add(&l, letters[x]);
+
+	salist_traverseForward(&l, &processWord);
+	printf("(%s)\n", (l.data == l.local ? "local" : "heap"));
+
+	// One more item spills the list to the heap
+	salist_add(&l, letters[x]);
+	salist_traverseForward(&l, &processWord);
+	printf("(%s)\n", (l.data == l.local ? "local" : "heap"));
+
+	printf("Remove 'C' and the item at 0, insert 'K' at 1\n");
+	salist_remove(&l, "C", &equals);
+	salist_removeAt(&l, 0);
+	salist_insert(&l, letters[10], 1);
+	salist_traverseBackward(&l, &processWord);
+	printf("\n");
+
+	printf("0: '%s'\n", (char*)salist_get(&l, 0));
+
+	// Releasing the list frees the heap array and uses the local one again
+	salist_release(&l);
+	if (salist_isEmpty(&l) && l.data == l.local)
+		printf("Released.\n");
+
+	// A list on the heap works the same way
+	SmallArrayList* h = newSmallArrayList();
+	salist_reserve(h, 20);
+	for (x = 0; x < 11; x++)
+		salist_add(h, letters[x]);
+
+	salist_traverseForward(h, &processWord);
+	printf("(capacity %u)\n", h->capacity);
+
+	salist_free(h);
+}
+
+void printChar(void* item)
+{
+	printf("%c", *((char*)item));
+}
+
+void exampleGapList()
+{
+	GapList* l = newGapList(4);
+
+	// Type some text one character at a time, each item points to a char
+	char* text = "Hello World";
+	int x;
+	for (x = 0; text[x] != '\0'; x++)
+		glist_add(l, &text[x]);
+
+	glist_traverseForward(l, &printChar);
+	printf("\n");
+
+	// Move the cursor after 'Hello' and type there, the gap follows the
+	// cursor so each character after the first is added in O(1)
+	char* typed = ", there";
+	for (x = 0; typed[x] != '\0'; x++)
+		glist_insert(l, &typed[x], 5 + x);
+
+	glist_traverseForward(l, &printChar);
+	printf("\n");
+
+	// Backspace over ' there' at the cursor
+	for (x = 0; x < 6; x++)
+		glist_removeAt(l, 11 - x);
+
+	glist_traverseForward(l, &printChar);
+	printf("\n");
+
+	// Items can be read and changed anywhere no matter where the gap is
+	glist_set(l, 0, &typed[2]);
+	printf("0: '%c' 7: '%c'\n", *((char*)glist_get(l, 0)), *((char*)glist_get(l, 7)));
+
+	glist_traverseBackward(l, &printChar);
+	printf("\n");
+
+	// Inserting past the end of the list does nothing
+	if (!glist_insert(l, &text[0], l->size + 1))
+		printf("Cannot insert past the end of the list.\n");
+
+	glist_clear(l);
+	if (glist_isEmpty(l))
+		printf("Gap list cleared.\n");
+
+	glist_free(l);
+}
+
+int matchesArrayList(ChunkList* c, ArrayList* a)
+{
+	if (c->size != a->size)
+		return 0;
+
+	unsigned int i;
+	for (i = 0; i < a->size; i++)
+		if (clist_get(c, i) != alist_get(a, i))
+			return 0;
+
+	return 1;
+}
+
+void exampleChunkList()
+{
+	ChunkList* l = newChunkList();
+
+	char* letters[] = {"A", "B", "C", "D", "E", "F"};
+	int x;
+	for (x = 0; x < 6; x++)
+		clist_add(l, letters[x]);
+
+	clist_traverseForward(l, &processWord);
+	printf("\n");
+
+	printf("Remove 'C' and the item at 0, insert 'F' at 2, set 0 to 'A'\n");
+	clist_remove(l, "C", &equals);
+	clist_removeAt(l, 0);
+	clist_insert(l, letters[5], 2);
+	clist_set(l, 0, letters[0]);
+	clist_traverseBackward(l, &processWord);
+	printf("\n");
+
+	// Fill the list until the tree has several levels of branches, doing
+	// the same to an array list to check every item is where it should be.
+	clist_clear(l);
+	ArrayList* a = newArrayList(16);
+	int* items = malloc(sizeof(int) * 100000);
+	unsigned int index;
+
+	for (x = 0; x < 100000; x++)
+	{
+		items[x] = x;
+
+		if (x % 3 == 0)
+		{
+			clist_add(l, &items[x]);
+			alist_add(a, &items[x]);
+		}
+		else
+		{
+			// Insert all over the list splitting chunks and branches
+			index = ((unsigned int)x * 7919) % (a->size + 1);
+			clist_insert(l, &items[x], index);
+			alist_insert(a, &items[x], index);
+		}
+	}
+
+	printf("Added 100000. Height: %u, Matches: %s\n", l->height,
+		(matchesArrayList(l, a) ? "yes" : "no"));
+
+	// Remove most items merging chunks and shrinking the tree
+	for (x = 0; x < 99000; x++)
+	{
+		index = ((unsigned int)x * 104729) % a->size;
+		clist_removeAt(l, index);
+		alist_removeAt(a, index);
+	}
+
+	printf("Removed 99000. Height: %u, Matches: %s\n", l->height,
+		(matchesArrayList(l, a) ? "yes" : "no"));
+
+	free(items);
+	alist_free(a);
+	clist_free(l);
+}
+
+unsigned int countNodes(UnrolledList* l)
+{
+	unsigned int count = 0;
+	UnrolledListNode* node = l->first;
+
+	while (node != NULL)
+	{
+		count++;
+		node = node->next;
+	}
+
+	return count;
+}
+
+void exampleUnrolledList()
+{
+	// Use pooling for efficiency, if you don't want to use pooling
+	// then comment out this line.
+	pool_ulist(16);
+
+	UnrolledList* L = newUnrolledList();
+
+	char* letters[] = {"b", "c", "d", "e", "f"};
+	int x;
+	for (x = 0; x < 5; x++)
+		ulist_add(L, letters[x]);
+
+	ulist_addFirst(L, "a");
+	ulist_traverse(L, &process);
+	printf("\n");
+
+	printf("Remove first: '%s'\n", (char*)ulist_removeFirst(L));
+	printf("2: '%s'\n", (char*)ulist_get(L, 2));
+
+	// Fill a full node of numbers and then insert after every one of them
+	// while traversing, which splits the nodes as they fill up.
+	ulist_clear(L);
+	int nums[ULIST_ITEMS * 2];
+	for (x = 0; x < ULIST_ITEMS * 2; x++)
+		nums[x] = x;
+
+	for (x = 0; x < ULIST_ITEMS * 2; x += 2)
+		ulist_add(L, &nums[x]);
+
+	printf("%u items in %u nodes\n", L->size, countNodes(L));
+
+	ulist_start(L);
+	while (ulist_hasNext(L))
+	{
+		x = *((int*)ulist_peek(L));
+		ulist_insertAfter(L, &nums[x + 1]);
+		ulist_next(L);
+		ulist_next(L);
+	}
+
+	printf("%u items in %u nodes\n", L->size, countNodes(L));
+
+	int inOrder = 1;
+	for (x = 0; x < L->size; x++)
+		if (*((int*)ulist_get(L, x)) != x)
+			inOrder = 0;
+
+	if (inOrder)
+		printf("Every item is in order.\n");
+
+	// Remove most of the items from the last node and then from the first,
+	// which leaves the first node half empty so it takes the items of the
+	// last node.
+	int half;
+	for (half = 1; half >= 0; half--)
+	{
+		ulist_start(L);
+		while (ulist_hasNext(L))
+		{
+			x = *((int*)ulist_peek(L));
+			if (x % 8 != 0 && x >= half * ULIST_ITEMS)
+				ulist_remove(L);
+			else
+				ulist_next(L);
+		}
+
+		printf("%u items in %u nodes\n", L->size, countNodes(L));
+	}
+
+	printf("Remaining: ");
+
+	ulist_start(L);
+	while (ulist_hasNext(L))
+		printf("%d ", *((int*)ulist_next(L)));
+	printf("\n");
+
+	// This will clear the list of any nodes and pool them and then free
+	// the list itself from memory
+	ulist_free(L);
+
+	// If you're not using pooling this can be commented out. This will
+	// free all pooled nodes from memory. Always call this at the end
+	// of using any UnrolledList.
+	unpool_ulist();
+}
+
+// An item that can be in two lists at once
+typedef struct
+{
+	char* name;
+	// The link for the list of every job
+	ILink all;
+	// The link for the queue of jobs ready to run
+	ILink ready;
+
+} Job;
+
+void printJob(ILink* link)
+{
+	printf("%s ", ilist_entry(link, Job, all)->name);
+}
+
+void exampleIntrusiveList()
+{
+	// The jobs hold the links so no nodes are ever allocated
+	Job jobs[] = {{"A"}, {"B"}, {"C"}, {"D"}, {"E"}};
+	IList all;
+	ilist_init(&all);
+
+	int x;
+	for (x = 0; x < 5; x++)
+	{
+		ilink_init(&jobs[x].ready);
+		ilist_add(&all, &jobs[x].all);
+	}
+
+	ilist_traverse(&all, &printJob);
+	printf("\n");
+
+	// Remove an item from the middle without searching for it
+	printf("Remove 'C', insert it before 'A'\n");
+	ilist_remove(&all, &jobs[2].all);
+	ilist_insertBefore(&all, &jobs[2].all, &jobs[0].all);
+	ilist_traverse(&all, &printJob);
+	printf("\n");
+
+	// Walk the list backwards
+	ILink* link = ilist_last(&all);
+	while (link != NULL)
+	{
+		printJob(link);
+		link = ilist_previous(&all, link);
+	}
+	printf("\n");
+
+	// The same items can be in a queue through their other link
+	IQueue* ready = newIQueue();
+	iqueue_offer(ready, &jobs[3].ready);
+	iqueue_offer(ready, &jobs[1].ready);
+	iqueue_offer(ready, &jobs[4].ready);
+
+	if (ilink_isLinked(&jobs[1].ready) && !ilink_isLinked(&jobs[0].ready))
+		printf("B is ready, A is not.\n");
+
+	printf("Ready: ");
+	while (!ilist_isEmpty(ready))
+		printf("%s ", ilist_entry(iqueue_poll(ready), Job, ready)->name);
+	printf("\n");
+
+	// And in a stack, which pops in the reverse order
+	IStack* stack = newIStack();
+	for (x = 0; x < 3; x++)
+		istack_push(stack, &jobs[x].ready);
+
+	printf("Popped: ");
+	while ((link = istack_pop(stack)) != NULL)
+		printf("%s ", ilist_entry(link, Job, ready)->name);
+	printf("\n");
+
+	// The lists don't own the jobs, so freeing them leaves the jobs alone
+	ilist_clear(&all);
+	printf("Cleared. %s still exists.\n", jobs[0].name);
+
+	ilist_free(ready);
+	ilist_free(stack);
+}
+
+// The number of items each producer sends in the concurrent examples
+#define EXAMPLE_ITEMS	100000
+
+/**
+ * What a thread in the concurrent examples is given to work on.
+ */
+typedef struct
+{
+	// The structure the thread offers to or polls from.
+	void* target;
+	// The numbers the thread offers.
+	int* numbers;
+	// The number of items the thread offers or polls.
+	unsigned int count;
+	// How many times the thread polled each number.
+	unsigned int* counts;
+
+} ExampleWorker;
+
+// Returns an array of the numbers from 0 up to count to use as items.
+int* newNumbers(unsigned int count)
+{
+	int* numbers = malloc(sizeof(int) * count);
+
+	unsigned int i;
+	for (i = 0; i < count; i++)
+		numbers[i] = i;
+
+	return numbers;
+}
+
+// Sets up a worker that offers the given numbers.
+void initProducer(ExampleWorker* w, void* target, int* numbers, unsigned int count)
+{
+	w->target = target;
+	w->numbers = numbers;
+	w->count = count;
+	w->counts = NULL;
+}
+
+// Sets up a worker that polls and counts some of the numbers up to total.
+void initConsumer(ExampleWorker* w, void* target, unsigned int count, unsigned int total)
+{
+	w->target = target;
+	w->numbers = NULL;
+	w->count = count;
+	w->counts = calloc(total, sizeof(unsigned int));
+}
+
+// Returns true if the workers polled every number exactly once between them.
+int polledOnce(ExampleWorker* workers, unsigned int workerCount, unsigned int total)
+{
+	unsigned int i, k, times;
+	int once = 1;
+
+	for (i = 0; i < total; i++)
+	{
+		times = 0;
+		for (k = 0; k < workerCount; k++)
+			times += workers[k].counts[i];
+
+		if (times != 1)
+			once = 0;
+	}
+
+	for (k = 0; k < workerCount; k++)
+		free(workers[k].counts);
+
+	return once;
+}
+
+void* spscProducer(void* arg)
+{
+	ExampleWorker* w = arg;
+	unsigned int i;
+
+	for (i = 0; i < w->count; i++)
+		while (!spsc_offer(w->target, &w->numbers[i]))
+			sched_yield();
+
+	return NULL;
+}
+
+void* spscConsumer(void* arg)
+{
+	ExampleWorker* w = arg;
+	void* buffer[64];
+	unsigned int polled = 0;
+	unsigned int i, n;
+
+	while (polled < w->count)
+	{
+		n = spsc_pollMany(w->target, buffer, 64);
+		if (n == 0)
+			sched_yield();
+
+		for (i = 0; i < n; i++)
+			w->counts[*((int*)buffer[i])]++;
+
+		polled += n;
+	}
+
+	return NULL;
+}
+
+void exampleSpscQueue()
+{
+	SpscQueue* Q = newSpscQueue(4);
+
+	// A queue with strings, from a single thread
+	spsc_offer(Q, "First");
+	spsc_offer(Q, "In");
+	spsc_offer(Q, "First");
+	spsc_offer(Q, "Out.");
+
+	if (!spsc_offer(Q, "Full"))
+		printf("The queue is full with %u items.\n", spsc_size(Q));
+
+	printf("%s\n", (char*)spsc_peek(Q));
+
+	while (!spsc_isEmpty(Q))
+		printf("%s ", (char*)spsc_poll(Q));
+	printf("\n");
+
+	// Offer and poll several items at once
+	char* letters[] = {"A", "B", "C", "D", "E", "F"};
+	void* buffer[6];
+	printf("Offered %u of 6\n", spsc_offerMany(Q, (void**)letters, 6));
+	unsigned int n = spsc_pollMany(Q, buffer, 6);
+	unsigned int i;
+	for (i = 0; i < n; i++)
+		printf("%s ", (char*)buffer[i]);
+	printf("\n");
+
+	if (spsc_poll(Q) == NULL)
+		printf("The queue is empty.\n");
+
+	spsc_free(Q);
+
+	// One thread offers numbers while another polls them
+	Q = newSpscQueue(1024);
+	int* numbers = newNumbers(EXAMPLE_ITEMS);
+	ExampleWorker producer, consumer;
+	initProducer(&producer, Q, numbers, EXAMPLE_ITEMS);
+	initConsumer(&consumer, Q, EXAMPLE_ITEMS, EXAMPLE_ITEMS);
+
+	pthread_t threads[2];
+	pthread_create(&threads[0], NULL, &spscProducer, &producer);
+	pthread_create(&threads[1], NULL, &spscConsumer, &consumer);
+	pthread_join(threads[0], NULL);
+	pthread_join(threads[1], NULL);
+
+	if (polledOnce(&consumer, 1, EXAMPLE_ITEMS))
+		printf("Every item arrived exactly once.\n");
+	else
+		printf("Items were lost or arrived more then once!\n");
+
+	free(numbers);
+	spsc_free(Q);
+}
+
+void* mpmcProducer(void* arg)
+{
+	ExampleWorker* w = arg;
+	unsigned int i;
+
+	for (i = 0; i < w->count; i++)
+		mpmc_offer(w->target, &w->numbers[i]);
+
+	return NULL;
+}
+
+void* mpmcConsumer(void* arg)
+{
+	ExampleWorker* w = arg;
+	unsigned int i;
+
+	for (i = 0; i < w->count; i++)
+		w->counts[*((int*)mpmc_poll(w->target))]++;
+
+	return NULL;
+}
+
+void exampleMpmcQueue()
+{
+	MpmcQueue* Q = newMpmcQueue(4);
+
+	// A queue with strings, from a single thread
+	mpmc_tryOffer(Q, "First");
+	mpmc_tryOffer(Q, "In");
+	mpmc_tryOffer(Q, "First");
+	mpmc_tryOffer(Q, "Out.");
+
+	if (!mpmc_tryOffer(Q, "Full"))
+		printf("The queue is full with %u items.\n", mpmc_size(Q));
+
+	while (!mpmc_isEmpty(Q))
+		printf("%s ", (char*)mpmc_tryPoll(Q));
+	printf("\n");
+
+	if (mpmc_tryPoll(Q) == NULL)
+		printf("The queue is empty.\n");
+
+	mpmc_free(Q);
+
+	// Two threads offer half of the numbers each while two other threads
+	// poll half of the numbers each.
+	Q = newMpmcQueue(256);
+	int* numbers = newNumbers(EXAMPLE_ITEMS);
+	unsigned int half = EXAMPLE_ITEMS / 2;
+	ExampleWorker producers[2], consumers[2];
+	pthread_t threads[4];
+	int i;
+
+	for (i = 0; i < 2; i++)
+	{
+		initProducer(&producers[i], Q, numbers + i * half, half);
+		initConsumer(&consumers[i], Q, half, EXAMPLE_ITEMS);
+		pthread_create(&threads[i], NULL, &mpmcProducer, &producers[i]);
+		pthread_create(&threads[i + 2], NULL, &mpmcConsumer, &consumers[i]);
+	}
+
+	for (i = 0; i < 4; i++)
+		pthread_join(threads[i], NULL);
+
+	if (polledOnce(consumers, 2, EXAMPLE_ITEMS))
+		printf("Every item arrived exactly once.\n");
+	else
+		printf("Items were lost or arrived more then once!\n");
+
+	free(numbers);
+	mpmc_free(Q);
+}
+
+// Set once the owner of the deque has pushed and popped everything it can.
+atomic_int wsdequeDone;
+
+void* wsdequeOwner(void* arg)
+{
+	ExampleWorker* w = arg;
+	void* item;
+	unsigned int i;
+
+	// Push every number, popping some of them back off along the way.
+	for (i = 0; i < w->count; i++)
+	{
+		wsdeque_push(w->target, &w->numbers[i]);
+
+		if (i % 3 == 0 && (item = wsdeque_pop(w->target)) != NULL)
+			w->counts[*((int*)item)]++;
+	}
+
+	while ((item = wsdeque_pop(w->target)) != NULL)
+		w->counts[*((int*)item)]++;
+
+	atomic_store(&wsdequeDone, 1);
+
+	return NULL;
+}
+
+void* wsdequeThief(void* arg)
+{
+	ExampleWorker* w = arg;
+	void* item;
+
+	for (;;)
+	{
+		if ((item = wsdeque_steal(w->target)) != NULL)
+			w->counts[*((int*)item)]++;
+		else if (atomic_load(&wsdequeDone) && wsdeque_isEmpty(w->target))
+			break;
+		else
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+void exampleWorkStealingDeque()
+{
+	WorkStealingDeque* D = newWorkStealingDeque(2);
+
+	// The owner pushes and pops at the bottom, the ring grows as needed
+	char* letters[] = {"A", "B", "C", "D", "E", "F"};
+	int i;
+	for (i = 0; i < 6; i++)
+		wsdeque_push(D, letters[i]);
+
+	printf("Size: %u\n", wsdeque_size(D));
+	printf("Pop: '%s'\n", (char*)wsdeque_pop(D));
+
+	// Thieves steal the oldest items from the top
+	printf("Steal: '%s'\n", (char*)wsdeque_steal(D));
+	printf("Steal: '%s'\n", (char*)wsdeque_steal(D));
+
+	printf("Popping.. ");
+	while (!wsdeque_isEmpty(D))
+		printf("%s ", (char*)wsdeque_pop(D));
+	printf("\n");
+
+	if (wsdeque_pop(D) == NULL && wsdeque_steal(D) == NULL)
+		printf("The deque is empty.\n");
+
+	wsdeque_free(D);
+
+	// The owner pushes and pops numbers while three thieves steal them
+	D = newWorkStealingDeque(16);
+	int* numbers = newNumbers(EXAMPLE_ITEMS);
+	ExampleWorker workers[4];
+	pthread_t threads[4];
+
+	atomic_init(&wsdequeDone, 0);
+
+	initConsumer(&workers[0], D, EXAMPLE_ITEMS, EXAMPLE_ITEMS);
+	workers[0].numbers = numbers;
+	pthread_create(&threads[0], NULL, &wsdequeOwner, &workers[0]);
+
+	for (i = 1; i < 4; i++)
+	{
+		initConsumer(&workers[i], D, 0, EXAMPLE_ITEMS);
+		pthread_create(&threads[i], NULL, &wsdequeThief, &workers[i]);
+	}
+
+	for (i = 0; i < 4; i++)
+		pthread_join(threads[i], NULL);
+
+	if (polledOnce(workers, 4, EXAMPLE_ITEMS))
+		printf("Every item arrived exactly once.\n");
+	else
+		printf("Items were lost or arrived more then once!\n");
+
+	free(numbers);
+	wsdeque_free(D);
+}
+
+// Returns the number of milliseconds since the given time.
+long millisSince(struct timespec* start)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (now.tv_sec - start->tv_sec) * 1000 + (now.tv_nsec - start->tv_nsec) / 1000000;
+}
+
+void* bqueueProducer(void* arg)
+{
+	ExampleWorker* w = arg;
+	unsigned int i;
+
+	for (i = 0; i < w->count; i++)
+		bqueue_offer(w->target, &w->numbers[i]);
+
+	return NULL;
+}
+
+void* bqueueConsumer(void* arg)
+{
+	ExampleWorker* w = arg;
+	void* buffer[32];
+	unsigned int polled = 0;
+	unsigned int i, n, max;
+
+	// Drain several items at once but never more then this thread's share
+	while (polled < w->count)
+	{
+		max = w->count - polled;
+		n = bqueue_drainTo(w->target, buffer, (max < 32 ? max : 32));
+
+		for (i = 0; i < n; i++)
+			w->counts[*((int*)buffer[i])]++;
+
+		polled += n;
+	}
+
+	return NULL;
+}
+
+void exampleBlockingQueue()
+{
+	BlockingQueue* Q = newBlockingQueue(4);
+
+	// A queue with strings, from a single thread
+	bqueue_offer(Q, "First");
+	bqueue_offer(Q, "In");
+	bqueue_offer(Q, "First");
+	bqueue_offer(Q, "Out.");
+
+	printf("Size: %u\n", bqueue_size(Q));
+
+	// Offering to a full queue gives up once the time is up
+	struct timespec start;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (!bqueue_offerTimeout(Q, "Full", 50))
+		printf("Offer timed out, waited at least 50ms: %s\n",
+			(millisSince(&start) >= 50 ? "yes" : "no"));
+
+	void* buffer[4];
+	unsigned int n = bqueue_drainTo(Q, buffer, 4);
+	unsigned int i;
+	for (i = 0; i < n; i++)
+		printf("%s ", (char*)buffer[i]);
+	printf("\n");
+
+	// Polling an empty queue gives up once the time is up
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (bqueue_pollTimeout(Q, 50) == NULL)
+		printf("Poll timed out, waited at least 50ms: %s\n",
+			(millisSince(&start) >= 50 ? "yes" : "no"));
+
+	// With no time to wait they return right away
+	if (bqueue_pollTimeout(Q, 0) == NULL)
+		printf("The queue is empty.\n");
+
+	if (bqueue_offerTimeout(Q, "Again", 0))
+		printf("Poll: '%s'\n", (char*)bqueue_pollTimeout(Q, 0));
+
+	bqueue_free(Q);
+
+	// Two threads offer half of the numbers each while two other threads
+	// drain half of the numbers each.
+	Q = newBlockingQueue(64);
+	int* numbers = newNumbers(EXAMPLE_ITEMS);
+	unsigned int half = EXAMPLE_ITEMS / 2;
+	ExampleWorker producers[2], consumers[2];
+	pthread_t threads[4];
+
+	for (i = 0; i < 2; i++)
+	{
+		initProducer(&producers[i], Q, numbers + i * half, half);
+		initConsumer(&consumers[i], Q, half, EXAMPLE_ITEMS);
+		pthread_create(&threads[i], NULL, &bqueueProducer, &producers[i]);
+		pthread_create(&threads[i + 2], NULL, &bqueueConsumer, &consumers[i]);
+	}
+
+	for (i = 0; i < 4; i++)
+		pthread_join(threads[i], NULL);
+
+	if (polledOnce(consumers, 2, EXAMPLE_ITEMS))
+		printf("Every item arrived exactly once.\n");
+	else
+		printf("Items were lost or arrived more then once!\n");
+
+	free(numbers);
+	bqueue_free(Q);
+}
+
+/**
+ * A range of indices to count, which a task splits in half until it's
+ * small enough to count itself.
+ */
+typedef struct
+{
+	// The scheduler to spawn tasks on.
+	Scheduler* scheduler;
+	// How many times each index was counted.
+	unsigned int* counts;
+	// The first index in the range.
+	unsigned int start;
+	// The index after the last index in the range.
+	unsigned int end;
+
+} CountRange;
+
+void countRange(void* arg)
+{
+	CountRange* r = arg;
+	unsigned int i;
+
+	if (r->end - r->start <= 1000)
+	{
+		for (i = r->start; i < r->end; i++)
+			r->counts[i]++;
+		return;
+	}
+
+	// Spawn the left half for another worker to steal and count the right
+	// half on this one, then wait for the left half to be done.
+	unsigned int middle = r->start + (r->end - r->start) / 2;
+	CountRange left = {r->scheduler, r->counts, r->start, middle};
+	CountRange right = {r->scheduler, r->counts, middle, r->end};
+	TaskGroup g;
+
+	taskgroup_init(&g);
+	scheduler_spawn(r->scheduler, &g, &countRange, &left);
+	countRange(&right);
+	scheduler_wait(r->scheduler, &g);
+}
+
+void countChunk(unsigned int start, unsigned int end, void* arg)
+{
+	unsigned int* counts = arg;
+	unsigned int i;
+
+	for (i = start; i < end; i++)
+		counts[i]++;
+}
+
+void* sumChunk(unsigned int start, unsigned int end, void* arg)
+{
+	long long* sum = malloc(sizeof(long long));
+	unsigned int i;
+
+	*sum = 0;
+	for (i = start; i < end; i++)
+		*sum += i;
+
+	return sum;
+}
+
+void* addSums(void* a, void* b)
+{
+	*((long long*)a) += *((long long*)b);
+	free(b);
+
+	return a;
+}
+
+// Returns true if every index was counted exactly once, and starts the
+// counts over again.
+int countedOnce(unsigned int* counts, unsigned int count)
+{
+	unsigned int i;
+	int once = 1;
+
+	for (i = 0; i < count; i++)
+	{
+		if (counts[i] != 1)
+			once = 0;
+
+		counts[i] = 0;
+	}
+
+	return once;
+}
+
+void exampleScheduler()
+{
+	Scheduler* S = newScheduler(4);
+	unsigned int* counts = calloc(EXAMPLE_ITEMS, sizeof(unsigned int));
+	int x;
+
+	// Tasks which spawn and wait on tasks of their own
+	CountRange all = {S, counts, 0, EXAMPLE_ITEMS};
+	TaskGroup g;
+	taskgroup_init(&g);
+	scheduler_spawn(S, &g, &countRange, &all);
+	scheduler_wait(S, &g);
+
+	printf("Fork-join counted every index once: %s\n",
+		(countedOnce(counts, EXAMPLE_ITEMS) ? "yes" : "no"));
+
+	// A loop split across the workers
+	scheduler_parallelFor(S, EXAMPLE_ITEMS, 0, &countChunk, counts);
+
+	printf("Parallel for counted every index once: %s\n",
+		(countedOnce(counts, EXAMPLE_ITEMS) ? "yes" : "no"));
+
+	scheduler_free(S);
+
+	// Start and stop schedulers over and over, half of them right after
+	// running some tasks, to check that stopping never hangs.
+	for (x = 0; x < 200; x++)
+	{
+		S = newScheduler(4);
+
+		if (x % 2 == 0)
+		{
+			all.scheduler = S;
+			taskgroup_init(&g);
+			scheduler_spawn(S, &g, &countRange, &all);
+			scheduler_wait(S, &g);
+			countedOnce(counts, EXAMPLE_ITEMS);
+		}
+
+		scheduler_free(S);
+	}
+
+	printf("Started and stopped %d schedulers.\n", x);
+
+	// The same loops on the default scheduler
+	parallel_for(EXAMPLE_ITEMS, 1000, 0, &countChunk, counts);
+
+	printf("parallel_for counted every index once: %s\n",
+		(countedOnce(counts, EXAMPLE_ITEMS) ? "yes" : "no"));
+
+	long long* sum = parallel_reduce(EXAMPLE_ITEMS, 1000, 0, &sumChunk, &addSums, NULL, 1);
+	printf("parallel_reduce sum: %lld (expected %lld)\n", *sum,
+		(long long)EXAMPLE_ITEMS * (EXAMPLE_ITEMS - 1) / 2);
+	free(sum);
+
+	free(counts);
+}
+
+void displaySegments(ArraySegment* segments, unsigned int count)
+{
+	unsigned int i, k;
+	for (i = 0; i < count; i++)
+	{
+		printf("[");
+		for (k = 0; k < segments[i].length; k++)
+			printf(" %s", (char*)segments[i].data[k]);
+		printf(" ] ");
+	}
+	printf("(%u segments)\n", count);
+}
+
+void exampleArrayQueueSegments()
+{
+	ArrayQueue* Q = newArrayQueue(8);
+	char* letters[] = {"A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K"};
+	void* buffer[8];
+	ArraySegment segments[2];
+	unsigned int i, n;
+
+	// Move the front of the queue into the middle of its array
+	aqueue_offerMany(Q, (void**)letters, 6);
+	n = aqueue_pollMany(Q, buffer, 4);
+	printf("Polled %u: ", n);
+	for (i = 0; i < n; i++)
+		printf("%s ", (char*)buffer[i]);
+	printf("\n");
+
+	// Adding more items wraps them around the end of the array
+	aqueue_offerMany(Q, (void**)&letters[6], 5);
+
+	// An offer that doesn't fit adds nothing
+	if (!aqueue_offerMany(Q, (void**)letters, 2))
+		printf("Cannot offer 2 more, the queue has %d of %d items.\n", Q->size, Q->capacity);
+
+	// The items can be read in place, in two runs since they wrap around
+	n = aqueue_readSegments(Q, segments);
+	displaySegments(segments, n);
+
+	// Remove the items that were read up to the end of the first run
+	aqueue_commitRead(Q, segments[0].length);
+	printf("Read %u, %d left: ", segments[0].length, Q->size);
+	aqueue_traverseForward(Q, &processWord);
+	printf("\n");
+
+	// Write new items straight into the free slots
+	n = aqueue_writeSegments(Q, segments);
+	unsigned int written = 0;
+	for (i = 0; i < n; i++)
+	{
+		memcpy(segments[i].data, &letters[written], segments[i].length * sizeof(void*));
+		written += segments[i].length;
+	}
+
+	aqueue_commitWrite(Q, written);
+	printf("Wrote %u into %u segments: ", written, n);
+	aqueue_traverseForward(Q, &processWord);
+	printf("\n");
+
+	// A full queue has no free slots
+	if (aqueue_writeSegments(Q, segments) == 0 && !aqueue_commitWrite(Q, 1))
+		printf("The queue is full.\n");
+
+	aqueue_free(Q);
+
+	// A deque has the same segments
+	ArrayDeque* D = newArrayDeque(4);
+	adeque_pushLast(D, "B");
+	adeque_pushLast(D, "C");
+	adeque_pushFirst(D, "A");
+
+	n = adeque_readSegments(D, segments);
+	displaySegments(segments, n);
+
+	n = adeque_writeSegments(D, segments);
+	segments[0].data[0] = "D";
+	adeque_commitWrite(D, 1);
+	adeque_commitRead(D, 2);
+	adeque_traverseForward(D, &processWord);
+	printf("\n");
+
+	adeque_free(D);
+}
+
+void exampleArrayDeque()
+{
+	ArrayDeque* D = newArrayDeque(8);
+	char* letters[] = {"A", "B", "C", "D", "E", "F", "G", "H"};
+	int x;
+
+	for (x = 0; x < 5; x++)
+		adeque_pushLast(D, letters[x]);
+
+	adeque_traverseForward(D, &processWord);
+	printf("\n");
+
+	// Move items from the end to the front, and from the front to the end
+	printf("Rotate 2: ");
+	adeque_rotate(D, 2);
+	adeque_traverseForward(D, &processWord);
+	printf("\n");
+
+	printf("Rotate -3: ");
+	adeque_rotate(D, -3);
+	adeque_traverseForward(D, &processWord);
+	printf("\n");
+
+	// Rotating by more then the size wraps around
+	printf("Rotate 11: ");
+	adeque_rotate(D, 11);
+	adeque_traverseForward(D, &processWord);
+	printf("\n");
+
+	// A full deque rotates by only moving its head and tail
+	for (x = 5; x < 8; x++)
+		adeque_pushLast(D, letters[x]);
+
+	printf("Full, rotate -2: ");
+	adeque_rotate(D, -2);
+	adeque_traverseForward(D, &processWord);
+	printf("\n");
+
+	printf("Set 0 to 'H' and 7 to 'A'\n");
+	adeque_set(D, 0, letters[7]);
+	adeque_set(D, 7, letters[0]);
+	if (!adeque_set(D, 8, letters[0]))
+		printf("Cannot set 8, the deque has %d items.\n", D->size);
+
+	for (x = 0; x < D->size; x++)
+		printf("%s ", (char*)adeque_peek(D, x));
+	printf("\n");
+
+	adeque_free(D);
+
+	// Copy the items of a List and a Queue for O(1) access by index
+	List* L = newList();
+	Queue* Q = newQueue();
+	for (x = 0; x < 4; x++)
+	{
+		list_add(L, letters[x]);
+		queue_offer(Q, letters[7 - x]);
+	}
+
+	D = adeque_fromList(L);
+	printf("From list: '%s' at 2 of %d\n", (char*)adeque_peek(D, 2), D->size);
+	adeque_free(D);
+
+	D = adeque_fromQueue(Q);
+	printf("From queue: '%s' at 2 of %d\n", (char*)adeque_peek(D, 2), D->size);
+	adeque_free(D);
+
+	list_free(L);
+	queue_free(Q);
+}
+
+void exampleMultiLevelQueue()
+{
+	// Every round polls 3 high, 2 medium and 1 low item
+	unsigned int weights[] = {3, 2, 1};
+	MultiLevelQueue* Q = newMultiLevelQueue(3, weights);
+	char* names[] = {"H", "M", "L"};
+	unsigned int level;
+	int x;
+
+	for (x = 0; x < 12; x++)
+		for (level = 0; level < 3; level++)
+			mlqueue_offer(Q, level, names[level]);
+
+	printf("Peek: '%s'\n", (char*)mlqueue_peek(Q));
+
+	printf("Polling 18.. ");
+	for (x = 0; x < 18; x++)
+		printf("%s", (char*)mlqueue_poll(Q));
+	printf("\n");
+
+	for (level = 0; level < 3; level++)
+		printf("Level %u: %lu polled, %u left\n", level, Q->levels[level].polled,
+			mlqueue_levelSize(Q, level));
+
+	// Give the low level the largest share from the next round on
+	printf("Set the weight of level 2 to 4\n");
+	mlqueue_setWeight(Q, 2, 4);
+	mlqueue_resetStats(Q);
+
+	// Levels that run out of items give up the rest of their round
+	printf("Polling.. ");
+	while (!mlqueue_isEmpty(Q))
+		printf("%s", (char*)mlqueue_poll(Q));
+	printf("\n");
+
+	for (level = 0; level < 3; level++)
+		printf("Level %u: %lu polled\n", level, Q->levels[level].polled);
+
+	if (!mlqueue_offer(Q, 3, "X"))
+		printf("Cannot offer to level 3, the queue has %u levels.\n", Q->levelCount);
+
+	mlqueue_offer(Q, 1, "M");
+	mlqueue_clear(Q);
+	if (mlqueue_poll(Q) == NULL)
+		printf("Multi-level queue cleared.\n");
+
+	mlqueue_free(Q);
+}
+
+/**
+ * An event in the disruptor examples.
+ */
+typedef struct
+{
+	// The value the producer wrote.
+	int value;
+	// The value doubled, written by the first stage of consumers.
+	int doubled;
+
+} ExampleEvent;
+
+void printEvent(void* event, unsigned long long sequence, void* arg)
+{
+	printf("%llu:%d ", sequence, ((ExampleEvent*)event)->value);
+}
+
+void countEvent(void* event, unsigned long long sequence, void* arg)
+{
+	ExampleWorker* w = arg;
+	w->counts[((ExampleEvent*)event)->value]++;
+}
+
+void doubleEvent(void* event, unsigned long long sequence, void* arg)
+{
+	ExampleEvent* e = event;
+	e->doubled = e->value * 2;
+
+	countEvent(event, sequence, arg);
+}
+
+void checkDoubled(void* event, unsigned long long sequence, void* arg)
+{
+	ExampleEvent* e = event;
+
+	// Only count the event if the stage before this one got to it first
+	if (e->doubled == e->value * 2)
+		countEvent(event, sequence, arg);
+}
+
+// Handles events for a consumer until it has seen all of them.
+void consumeAll(ExampleWorker* w, void (*handler)(void* event, unsigned long long sequence, void* arg))
+{
+	unsigned int consumed = 0;
+
+	while (consumed < w->count)
+		consumed += disruptor_consume(w->target, handler, w);
+}
+
+void* disruptorDoubler(void* arg)
+{
+	consumeAll(arg, &doubleEvent);
+	return NULL;
+}
+
+void* disruptorCounter(void* arg)
+{
+	consumeAll(arg, &countEvent);
+	return NULL;
+}
+
+void* disruptorChecker(void* arg)
+{
+	consumeAll(arg, &checkDoubled);
+	return NULL;
+}
+
+void* disruptorProducer(void* arg)
+{
+	ExampleWorker* w = arg;
+	unsigned long long sequence;
+	unsigned int i, k, batch;
+
+	// Publish the values in batches of up to 16 events
+	for (i = 0; i < w->count; i += batch)
+	{
+		batch = (w->count - i < 16 ? w->count - i : 16);
+		sequence = disruptor_claim(w->target, batch);
+
+		for (k = 0; k < batch; k++)
+		{
+			ExampleEvent* e = disruptor_get(w->target, sequence + k);
+			e->value = w->numbers[i + k];
+			e->doubled = 0;
+		}
+
+		disruptor_publish(w->target, batch);
+	}
+
+	return NULL;
+}
+
+void exampleDisruptor()
+{
+	Disruptor* D = newDisruptor(4, sizeof(ExampleEvent));
+	DisruptorConsumer* C = disruptor_addConsumer(D, NULL, 0);
+	unsigned long long sequence;
+	ExampleEvent* e;
+	int x;
+
+	// Claim three slots, write the events in place and publish them
+	sequence = disruptor_claim(D, 3);
+	for (x = 0; x < 3; x++)
+	{
+		e = disruptor_get(D, sequence + x);
+		e->value = (x + 1) * 10;
+	}
+	disruptor_publish(D, 3);
+
+	printf("Available: %u\n", disruptor_available(C));
+
+	// The ring is full until the consumer releases what it has read
+	if (!disruptor_tryClaim(D, 2, &sequence))
+		printf("Cannot claim 2 more, the consumer hasn't read them yet.\n");
+
+	printf("Consuming.. ");
+	unsigned int n = disruptor_consume(C, &printEvent, NULL);
+	printf("(%u events)\n", n);
+
+	if (disruptor_tryClaim(D, 2, &sequence))
+	{
+		((ExampleEvent*)disruptor_get(D, sequence))->value = 40;
+		((ExampleEvent*)disruptor_get(D, sequence + 1))->value = 50;
+		disruptor_publish(D, 2);
+	}
+
+	// Read the events in place and release them
+	n = disruptor_waitFor(C);
+	for (x = 0; x < n; x++)
+		printf("%d ", ((ExampleEvent*)disruptor_get(D, C->sequence + x))->value);
+	printf("\n");
+	disruptor_release(C, n);
+
+	if (disruptor_available(C) == 0)
+		printf("Every event was read.\n");
+
+	disruptor_free(D);
+
+	// One thread publishes numbers to two consumers that each see every
+	// one, and a third consumer that reads them after the first has
+	// doubled them.
+	D = newDisruptor(256, sizeof(ExampleEvent));
+	int* numbers = newNumbers(EXAMPLE_ITEMS);
+	ExampleWorker producer, consumers[3];
+	pthread_t threads[4];
+
+	DisruptorConsumer* doubler = disruptor_addConsumer(D, NULL, 0);
+	DisruptorConsumer* counter = disruptor_addConsumer(D, NULL, 0);
+	DisruptorConsumer* checker = disruptor_addConsumer(D, &doubler, 1);
+
+	initProducer(&producer, D, numbers, EXAMPLE_ITEMS);
+	initConsumer(&consumers[0], doubler, EXAMPLE_ITEMS, EXAMPLE_ITEMS);
+	initConsumer(&consumers[1], counter, EXAMPLE_ITEMS, EXAMPLE_ITEMS);
+	initConsumer(&consumers[2], checker, EXAMPLE_ITEMS, EXAMPLE_ITEMS);
+
+	pthread_create(&threads[0], NULL, &disruptorDoubler, &consumers[0]);
+	pthread_create(&threads[1], NULL, &disruptorCounter, &consumers[1]);
+	pthread_create(&threads[2], NULL, &disruptorChecker, &consumers[2]);
+	pthread_create(&threads[3], NULL, &disruptorProducer, &producer);
+
+	for (x = 0; x < 4; x++)
+		pthread_join(threads[x], NULL);
+
+	for (x = 0; x < 3; x++)
+	{
+		if (polledOnce(&consumers[x], 1, EXAMPLE_ITEMS))
+			printf("Consumer %d saw every event exactly once.\n", x);
+		else
+			printf("Consumer %d lost events or saw them more then once!\n", x);
+	}
+
+	free(numbers);
+	disruptor_free(D);
+}
+
+void exampleSegmentedStack()
+{
+	SegmentedStack* S = newSegmentedStack();
+
+	// A stack with strings
+	sstack_push(S, "Out.");
+	sstack_push(S, "First");
+	sstack_push(S, "In");
+	sstack_push(S, "Last");
+
+	printf("%s\n", (char*)sstack_peek(S));
+
+	sstack_traverseDown(S, &processWord);
+	printf("\n");
+
+	while (!sstack_isEmpty(S))
+		printf("%s ", (char*)sstack_pop(S));
+	printf("\n");
+
+	// Fill the first chunk exactly
+	int* numbers = newNumbers(SSTACK_CHUNK * 3);
+	int x;
+	for (x = 0; x < SSTACK_CHUNK; x++)
+		sstack_push(S, &numbers[x]);
+
+	SegmentedStackChunk* first = S->top;
+	printf("%u items, %u in the top chunk\n", S->size, S->count);
+
+	// Push and pop back and forth across the edge of the chunk, the chunk
+	// above is kept as a spare so it's only allocated once.
+	sstack_push(S, &numbers[x]);
+	SegmentedStackChunk* second = S->top;
+	printf("%u items, %u in the top chunk\n", S->size, S->count);
+
+	printf("Pop: %d\n", *((int*)sstack_pop(S)));
+	printf("Pop: %d\n", *((int*)sstack_pop(S)));
+	if (S->top == first)
+		printf("Back in the first chunk, %u in the top chunk\n", S->count);
+
+	sstack_push(S, &numbers[SSTACK_CHUNK - 1]);
+	sstack_push(S, &numbers[SSTACK_CHUNK]);
+	if (S->top == second)
+		printf("The spare chunk was reused.\n");
+
+	// Fill three chunks and check every item pops in the reverse order
+	for (x = SSTACK_CHUNK + 1; x < SSTACK_CHUNK * 3; x++)
+		sstack_push(S, &numbers[x]);
+
+	int ordered = 1;
+	for (x = SSTACK_CHUNK * 3 - 1; x >= 0; x--)
+		if (*((int*)sstack_pop(S)) != x)
+			ordered = 0;
+
+	if (ordered && sstack_pop(S) == NULL)
+		printf("Popped all %d items in order.\n", SSTACK_CHUNK * 3);
+
+	sstack_push(S, "Gone");
+	sstack_clear(S);
+	if (sstack_isEmpty(S))
+		printf("Segmented stack cleared.\n");
+
+	free(numbers);
+	sstack_free(S);
+}
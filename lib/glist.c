@@ -0,0 +1,215 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#include <string.h>
+
+#include "util.h"
+#include "glist.h"
+
+/**
+ * This is a gap-buffer list containing generic data. The operations that
+ * can be performed on a gap list are:
+ * 
+ * Get => Returns the item at an index in the list.
+ * Set => Sets the item at an index in the list.
+ * Add => Add an item to the end of the list.
+ * Insert => Insert an item into the list at some point.
+ * Remove => Remove an item from the list.
+ * RemoveAt => Remove an item at an index in the list.
+ * Resize => Changes the capacity of the gap list.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Free => Frees the list from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+// Returns the index in the array of the i'th item in the list.
+unsigned int glist_offset(GapList* l, unsigned int index)
+{
+	return (index < l->gapStart ? index : index + (l->gapEnd - l->gapStart));
+}
+
+// Moves the gap so it starts at the given index of the list, shifting
+// only the items between where the gap was and where it's going.
+void glist_moveGap(GapList* l, unsigned int index)
+{
+	if (index < l->gapStart)
+	{
+		unsigned int count = l->gapStart - index;
+
+		memmove(l->data + l->gapEnd - count, l->data + index, count * sizeof(void*));
+		l->gapStart -= count;
+		l->gapEnd -= count;
+	}
+	else if (index > l->gapStart)
+	{
+		unsigned int count = index - l->gapStart;
+
+		memmove(l->data + l->gapStart, l->data + l->gapEnd, count * sizeof(void*));
+		l->gapStart += count;
+		l->gapEnd += count;
+	}
+}
+
+// Returns a new gap list with no items, allocated to the heap.
+GapList* newGapList(unsigned int initialSize)
+{
+	GapList* l = alloc(GapList, 1);
+
+	l->size = 0;
+	l->capacity = max(initialSize, 1);
+	l->gapStart = 0;
+	l->gapEnd = l->capacity;
+	l->data = alloc(void*, l->capacity);
+
+	return l;
+}
+
+// Returns the i'th item in the gap list.
+void* glist_get(GapList* l, unsigned int index)
+{
+	if (index >= l->size)
+		return NULL;
+
+	return l->data[glist_offset(l, index)];
+}
+
+// Sets the i'th item in the gap list.
+int glist_set(GapList* l, unsigned int index, void* item)
+{
+	if (index >= l->size)
+		return false;
+
+	l->data[glist_offset(l, index)] = item;
+
+	return true;
+}
+
+// This will add an item to the end of the list.
+void glist_add(GapList* l, void* item)
+{
+	glist_insert(l, item, l->size);
+}
+
+// Inserts data into a gap list at the given index.
+int glist_insert(GapList* l, void* item, unsigned int index)
+{
+	if (index > l->size)
+		return false;
+
+	// If the list is full then double it, which makes a new gap.
+	if (l->size == l->capacity)
+		glist_resize(l, l->capacity << 1);
+
+	glist_moveGap(l, index);
+
+	l->data[l->gapStart++] = item;
+	l->size++;
+
+	return true;
+}
+
+// Removes the first item from the list that equals the given item.
+void* glist_remove(GapList* l, void* item, int (*equals)(void*, void*))
+{
+	unsigned int i;
+	for (i = 0; i < l->size; i++)
+		if (equals(item, l->data[glist_offset(l, i)]))
+			return glist_removeAt(l, i);
+
+	return NULL;
+}
+
+// Removes and returns the item at the given index.
+void* glist_removeAt(GapList* l, unsigned int index)
+{
+	if (index >= l->size)
+		return NULL;
+
+	glist_moveGap(l, index);
+
+	// The item is now right after the gap, so the gap swallows it.
+	void* item = l->data[l->gapEnd];
+	l->data[l->gapEnd++] = NULL;
+	l->size--;
+
+	return item;
+}
+
+// Returns true if the gap list has no items in it.
+int glist_isEmpty(GapList* l)
+{
+	return (l->size == 0);
+}
+
+// Resizes the capacity of the gap list, keeping the gap where it is.
+void glist_resize(GapList* l, unsigned int newSize)
+{
+	if (newSize == 0)
+		newSize = 1;
+
+	// Remove the items at the end that won't fit.
+	if (newSize < l->size)
+	{
+		glist_moveGap(l, newSize);
+		l->size = newSize;
+		l->gapEnd = l->capacity;
+	}
+
+	unsigned int after = l->capacity - l->gapEnd;
+	void** data = alloc(void*, newSize);
+
+	memcpy(data, l->data, l->gapStart * sizeof(void*));
+	memcpy(data + newSize - after, l->data + l->gapEnd, after * sizeof(void*));
+
+	free(l->data);
+
+	l->data = data;
+	l->gapEnd = newSize - after;
+	l->capacity = newSize;
+}
+
+// Traverses the list from front to back, skipping over the gap.
+void glist_traverseForward(GapList* l, void (*process)(void* item))
+{
+	unsigned int i;
+	for (i = 0; i < l->gapStart; i++)
+		process(l->data[i]);
+	for (i = l->gapEnd; i < l->capacity; i++)
+		process(l->data[i]);
+}
+
+// Traverses the list from back to front, skipping over the gap.
+void glist_traverseBackward(GapList* l, void (*process)(void* item))
+{
+	unsigned int i;
+	for (i = l->capacity; i > l->gapEnd; i--)
+		process(l->data[i - 1]);
+	for (i = l->gapStart; i > 0; i--)
+		process(l->data[i - 1]);
+}
+
+// Clears the list of all data.
+void glist_clear(GapList* l)
+{
+	l->size = 0;
+	l->gapStart = 0;
+	l->gapEnd = l->capacity;
+}
+
+// Removes the list completely from memory.
+void glist_free(GapList* l)
+{
+	if (l == NULL)
+		return;
+
+	free(l->data);
+	free(l);
+}
\ No newline at end of file
@@ -50,54 +50,54 @@ typedef struct
 } Pool;
 
 // The pool to use for any Queue's nodes.
-Pool* pool;
+Pool* hashPool;
 
 // Creates a pool of HashtableEntries.
 void pool_hashtable(unsigned int capacity)
 {
-	pool = alloc(Pool, 1);
+	hashPool = alloc(Pool, 1);
 
-	pool->capacity = capacity;
-	pool->size = 0;
-	pool->entries = alloc(HashtableEntry*, capacity);
+	hashPool->capacity = capacity;
+	hashPool->size = 0;
+	hashPool->entries = alloc(HashtableEntry*, capacity);
 }
 
 // Destroys the pool of HashtableEntries.
 void unpool_hashtable()
 {
-	if (pool == NULL)
+	if (hashPool == NULL)
 		return;
 	
 	unsigned int i;
-	for (i = 0; i < pool->size; i++)
-		free(pool->entries[i]);
+	for (i = 0; i < hashPool->size; i++)
+		free(hashPool->entries[i]);
 
-	free(pool->entries);
-	free(pool);
+	free(hashPool->entries);
+	free(hashPool);
 
-	pool = NULL;
+	hashPool = NULL;
 }
 
 // Returns a node from the pool or allocates a new one.
 HashtableEntry* pop_HashtableEntry()
 {
 	// Of pooling isn't supported then just allocate a new one.
-	if (pool == NULL)
+	if (hashPool == NULL)
 		return alloc(HashtableEntry, 1);
 
 	HashtableEntry* entry;
 
 	// If there are none on the pool then allocate a new one
-	if (pool->size == 0)
+	if (hashPool->size == 0)
 	{
 		entry = alloc(HashtableEntry, 1);
 	}
 	// If there is one on the pool grab one from the back.
 	else
 	{
-		pool->size--;
-		entry = pool->entries[pool->size];
-		pool->entries[pool->size] = NULL;
+		hashPool->size--;
+		entry = hashPool->entries[hashPool->size];
+		hashPool->entries[hashPool->size] = NULL;
 	}
 
 	return entry;
@@ -110,20 +110,20 @@ void push_HashtableEntry(HashtableEntry* entry)
 	if (entry == NULL)
 		return;
 	// If the pooling isn't supported then just free the node from memory.
-	else if (pool == NULL)
+	else if (hashPool == NULL)
 	{
 		free(entry);	
 		return;
 	}
 	// If the pool exists but is filled then exit.
-	else if (pool->size == pool->capacity)
+	else if (hashPool->size == hashPool->capacity)
 		return;
 
 	// push the node into the pool.
 	entry->data = NULL;
 	entry->key = 0;
 	entry->next = NULL;
-	pool->entries[pool->size++] = entry;
+	hashPool->entries[hashPool->size++] = entry;
 }
 
 // Returns an empty hashtable with a capacity which is a power
@@ -0,0 +1,240 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * This is an intrusive doubly linked-list, along with the queue and stack
+ * built on it. The operations that can be performed on an intrusive list
+ * are:
+ * 
+ * Init => Starts a list declared on the stack or in another structure.
+ * Add => Add an item to the end of the list.
+ * AddFirst => Adds an item to the beginning of the list.
+ * InsertBefore => Inserts an item before an item in the list.
+ * InsertAfter => Inserts an item after an item in the list.
+ * Remove => Removes an item from anywhere in the list.
+ * RemoveFirst => Removes and returns the first item in the list.
+ * RemoveLast => Removes and returns the last item in the list.
+ * First/Last => Returns the item at either end of the list.
+ * Next/Previous => Returns the item next to an item in the list.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Free => Frees the list from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+#include "util.h"
+#include "ilist.h"
+
+// Links an item in between two links that are next to each other.
+void ilist_link(IList* l, ILink* link, ILink* previous, ILink* next)
+{
+	link->previous = previous;
+	link->next = next;
+	previous->next = link;
+	next->previous = link;
+	l->size++;
+}
+
+// Returns a new intrusive list with no items, allocated to the heap.
+IList* newIList()
+{
+	IList* l = alloc(IList, 1);
+
+	ilist_init(l);
+
+	return l;
+}
+
+// Starts an intrusive list declared on the stack or in another structure.
+void ilist_init(IList* l)
+{
+	l->size = 0;
+	l->head.previous = &l->head;
+	l->head.next = &l->head;
+}
+
+// Starts a link so it's known to not be in any list.
+void ilink_init(ILink* link)
+{
+	link->previous = NULL;
+	link->next = NULL;
+}
+
+// Returns true if the link is in a list.
+int ilink_isLinked(ILink* link)
+{
+	return (link->next != NULL);
+}
+
+// Adds an item to the end of the list.
+void ilist_add(IList* l, ILink* link)
+{
+	ilist_link(l, link, l->head.previous, &l->head);
+}
+
+// Adds an item to the beginning of the list.
+void ilist_addFirst(IList* l, ILink* link)
+{
+	ilist_link(l, link, &l->head, l->head.next);
+}
+
+// Inserts an item before an item already in the list.
+void ilist_insertBefore(IList* l, ILink* link, ILink* at)
+{
+	ilist_link(l, link, at->previous, at);
+}
+
+// Inserts an item after an item already in the list.
+void ilist_insertAfter(IList* l, ILink* link, ILink* at)
+{
+	ilist_link(l, link, at, at->next);
+}
+
+// Removes an item from wherever it is in the list.
+void ilist_remove(IList* l, ILink* link)
+{
+	link->previous->next = link->next;
+	link->next->previous = link->previous;
+	link->previous = NULL;
+	link->next = NULL;
+	l->size--;
+}
+
+// Removes and returns the link of the first item in the list.
+ILink* ilist_removeFirst(IList* l)
+{
+	ILink* link = ilist_first(l);
+
+	if (link != NULL)
+		ilist_remove(l, link);
+
+	return link;
+}
+
+// Removes and returns the link of the last item in the list.
+ILink* ilist_removeLast(IList* l)
+{
+	ILink* link = ilist_last(l);
+
+	if (link != NULL)
+		ilist_remove(l, link);
+
+	return link;
+}
+
+// Returns the link of the first item in the list.
+ILink* ilist_first(IList* l)
+{
+	return ilist_next(l, &l->head);
+}
+
+// Returns the link of the last item in the list.
+ILink* ilist_last(IList* l)
+{
+	return ilist_previous(l, &l->head);
+}
+
+// Returns the link of the item after the given item in the list.
+ILink* ilist_next(IList* l, ILink* link)
+{
+	return (link->next == &l->head ? NULL : link->next);
+}
+
+// Returns the link of the item before the given item in the list.
+ILink* ilist_previous(IList* l, ILink* link)
+{
+	return (link->previous == &l->head ? NULL : link->previous);
+}
+
+// Returns true if the intrusive list has no items.
+int ilist_isEmpty(IList* l)
+{
+	return (l->size == 0);
+}
+
+// Traverses the list from front to back.
+void ilist_traverse(IList* l, void (*process)(ILink* link))
+{
+	ILink* link = l->head.next;
+	ILink* next;
+
+	// Read the next link first in case the current one is removed.
+	while (link != &l->head)
+	{
+		next = link->next;
+		process(link);
+		link = next;
+	}
+}
+
+// Clears the list of all items, leaving every link not linked.
+void ilist_clear(IList* l)
+{
+	while (l->size > 0)
+		ilist_remove(l, l->head.next);
+}
+
+// Clears the list and frees the list from memory.
+void ilist_free(IList* l)
+{
+	if (l == NULL)
+		return;
+
+	ilist_clear(l);
+	free(l);
+}
+
+// Returns a new intrusive queue with no items, allocated to the heap.
+IQueue* newIQueue()
+{
+	return newIList();
+}
+
+// Adds an item to the back of the queue.
+void iqueue_offer(IQueue* q, ILink* link)
+{
+	ilist_add(q, link);
+}
+
+// Removes and returns the link of the item at the front of the queue.
+ILink* iqueue_poll(IQueue* q)
+{
+	return ilist_removeFirst(q);
+}
+
+// Returns the link of the item at the front of the queue.
+ILink* iqueue_peek(IQueue* q)
+{
+	return ilist_first(q);
+}
+
+// Returns a new intrusive stack with no items, allocated to the heap.
+IStack* newIStack()
+{
+	return newIList();
+}
+
+// Pushes an item onto the top of the stack.
+void istack_push(IStack* s, ILink* link)
+{
+	ilist_addFirst(s, link);
+}
+
+// Removes and returns the link of the item on top of the stack.
+ILink* istack_pop(IStack* s)
+{
+	return ilist_removeFirst(s);
+}
+
+// Returns the link of the item on top of the stack.
+ILink* istack_peek(IStack* s)
+{
+	return ilist_first(s);
+}
\ No newline at end of file
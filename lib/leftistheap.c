@@ -0,0 +1,272 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * This is a leftist heap containing generic data which is ordered by some
+ * key value. Every node's right subtree is no taller down its right side
+ * then its left subtree, so two heaps can be melded by walking only down
+ * their right sides. The operations that can be performed on a leftist
+ * heap are:
+ *
+ * Add => Add an item to the leftist heap given a key.
+ * PeekMin => Returns the item that has the lowest key.
+ * PopMin => Removes and returns the item that has the lowest key.
+ * Meld => Moves all items from one leftist heap into another.
+ * Clear => Clears all items from the heap.
+ * Free => Frees the heap from memory.
+ *
+ * @author Philip Diffenderfer
+ */
+
+#include "util.h"
+#include "leftistheap.h"
+
+/**
+ * A pool is a stack like structure that can pop and push LeftistHeapNodes.
+ * If there are no LeftistHeapNodes to pop and a request is made then the
+ * pool will allocate a LeftistHeapNode on the spot. A pool is restricted
+ * by a maximum capcity.
+ */
+typedef struct
+{
+	// The current number of nodes available for unpooling.
+	unsigned int size;
+	// The maximum number of nodes that can be pooled.
+	unsigned int capacity;
+	// The array of node pointers for pooling/unpooling.
+	LeftistHeapNode** nodes;
+
+} Pool;
+
+
+// The pool to use for any LeftistHeap's nodes.
+Pool* leftistPool;
+
+
+// Creates a pool of LeftistHeapNodes.
+void pool_leftistheap(unsigned int capacity)
+{
+	leftistPool = alloc(Pool, 1);
+
+	leftistPool->capacity = capacity;
+	leftistPool->size = 0;
+	leftistPool->nodes = alloc(LeftistHeapNode*, capacity);
+}
+
+// Destroys the pool of LeftistHeapNodes.
+void unpool_leftistheap()
+{
+	if (leftistPool == NULL)
+		return;
+
+	unsigned int i;
+	for (i = 0; i < leftistPool->size; i++)
+		free(leftistPool->nodes[i]);
+
+	free(leftistPool->nodes);
+	free(leftistPool);
+
+	leftistPool = NULL;
+}
+
+// Returns a node from the pool or allocates a new one.
+LeftistHeapNode* pop_LeftistHeapNode()
+{
+	// If pooling isn't supported then just allocate a new one.
+	if (leftistPool == NULL)
+		return alloc(LeftistHeapNode, 1);
+
+	LeftistHeapNode* node;
+
+	// If there are none on the pool then allocate a new one
+	if (leftistPool->size == 0)
+	{
+		node = alloc(LeftistHeapNode, 1);
+	}
+	// If there is one on the pool grab one from the back.
+	else
+	{
+		leftistPool->size--;
+		node = leftistPool->nodes[leftistPool->size];
+		leftistPool->nodes[leftistPool->size] = NULL;
+	}
+
+	return node;
+}
+
+// Puts the node on the pool if there is space.
+void push_LeftistHeapNode(LeftistHeapNode* node)
+{
+	// If the node passed in is null just exit
+	if (node == NULL)
+		return;
+	// If the pooling isn't supported then just free the node from memory.
+	else if (leftistPool == NULL)
+	{
+		free(node);
+		return;
+	}
+	// If the pool exists but is filled then free the node.
+	else if (leftistPool->size == leftistPool->capacity)
+	{
+		free(node);
+		return;
+	}
+
+	// push the node into the pool.
+	node->data = NULL;
+	node->left = NULL;
+	node->right = NULL;
+	leftistPool->nodes[leftistPool->size++] = node;
+}
+
+// Returns the rank of a subtree, an empty subtree has a rank of 0.
+unsigned int leftistheap_rank(LeftistHeapNode* node)
+{
+	return (node == NULL ? 0 : node->rank);
+}
+
+// Melds two subtrees together walking down their right sides.
+LeftistHeapNode* leftistheap_join(LeftistHeapNode* a, LeftistHeapNode* b)
+{
+	if (a == NULL)
+		return b;
+	if (b == NULL)
+		return a;
+
+	if (b->key < a->key)
+	{
+		LeftistHeapNode* t = a;
+		a = b;
+		b = t;
+	}
+
+	a->right = leftistheap_join(a->right, b);
+
+	// Keep the subtree with the shorter right side on the right.
+	if (leftistheap_rank(a->left) < leftistheap_rank(a->right))
+	{
+		LeftistHeapNode* t = a->left;
+		a->left = a->right;
+		a->right = t;
+	}
+
+	a->rank = leftistheap_rank(a->right) + 1;
+
+	return a;
+}
+
+// Returns a new leftist heap with no items.
+LeftistHeap* newLeftistHeap()
+{
+	LeftistHeap* h = alloc(LeftistHeap, 1);
+
+	h->size = 0;
+	h->root = NULL;
+
+	return h;
+}
+
+// Adds to the leftist heap.
+int leftistheap_add(LeftistHeap* h, int key, void* item)
+{
+	LeftistHeapNode* node = pop_LeftistHeapNode();
+	node->data = item;
+	node->key = key;
+	node->rank = 1;
+	node->left = NULL;
+	node->right = NULL;
+
+	h->root = leftistheap_join(h->root, node);
+	h->size++;
+
+	return true;
+}
+
+// Removes the item with the minimum key from the top of the heap.
+void* leftistheap_popMin(LeftistHeap* h)
+{
+	if (h->root == NULL)
+		return NULL;
+
+	LeftistHeapNode* root = h->root;
+	void* item = root->data;
+
+	h->root = leftistheap_join(root->left, root->right);
+	h->size--;
+
+	push_LeftistHeapNode(root);
+
+	return item;
+}
+
+// Returns the item at the top of the leftist heap without removing it.
+void* leftistheap_peekMin(LeftistHeap* h)
+{
+	if (h->root == NULL)
+		return NULL;
+
+	return h->root->data;
+}
+
+// Moves all items from the other heap into the given heap.
+void leftistheap_meld(LeftistHeap* h, LeftistHeap* other)
+{
+	h->root = leftistheap_join(h->root, other->root);
+	h->size += other->size;
+
+	other->root = NULL;
+	other->size = 0;
+}
+
+// Returns true if the leftist heap has no items in it.
+int leftistheap_isEmpty(LeftistHeap* h)
+{
+	return (h->size == 0);
+}
+
+// Clears the leftist heap of all items.
+void leftistheap_clear(LeftistHeap* h)
+{
+	LeftistHeapNode* node = h->root;
+	LeftistHeapNode* next;
+
+	// Rotate left children up until the node has none, then pool it and
+	// move on to its right child. This visits every node without recursion.
+	while (node != NULL)
+	{
+		if (node->left != NULL)
+		{
+			next = node->left;
+			node->left = next->right;
+			next->right = node;
+		}
+		else
+		{
+			next = node->right;
+			push_LeftistHeapNode(node);
+		}
+
+		node = next;
+	}
+
+	h->root = NULL;
+	h->size = 0;
+}
+
+// Clears the leftist heap of all items and frees the nodes and the heap
+// from memory.
+void leftistheap_free(LeftistHeap* h)
+{
+	if (h == NULL)
+		return;
+
+	leftistheap_clear(h);
+	free(h);
+}
\ No newline at end of file
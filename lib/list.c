@@ -51,51 +51,51 @@ typedef struct
 
 
 // The pool to use for any Queue's nodes.
-Pool* pool;
+Pool* listPool;
 
 // Creates a pool of ListNodes.
 void pool_list(unsigned int capacity)
 {
-	pool = alloc(Pool, 1);
+	listPool = alloc(Pool, 1);
 
-	pool->capacity = capacity;
-	pool->size = 0;
-	pool->nodes = alloc(ListNode*, capacity);
+	listPool->capacity = capacity;
+	listPool->size = 0;
+	listPool->nodes = alloc(ListNode*, capacity);
 }
 
 // Destroys the pool of ListNodes.
 void unpool_list()
 {
-	if (pool == NULL)
+	if (listPool == NULL)
 		return;
 	
 	unsigned int i;
-	for (i = 0; i < pool->size; i++)
-		free(pool->nodes[i]);
+	for (i = 0; i < listPool->size; i++)
+		free(listPool->nodes[i]);
 
-	free(pool->nodes);
-	free(pool);
+	free(listPool->nodes);
+	free(listPool);
 
-	pool = NULL;
+	listPool = NULL;
 }
 
 // Returns a node from the pool or allocates a new one.
 ListNode* pop_ListNode()
 {
-	if (pool == NULL)
+	if (listPool == NULL)
 		return alloc(ListNode, 1);
 
 	ListNode* node;
 
-	if (pool->size == 0)
+	if (listPool->size == 0)
 	{
 		node = alloc(ListNode, 1);
 	}
 	else
 	{
-		pool->size--;
-		node = pool->nodes[pool->size];
-		pool->nodes[pool->size] = NULL;
+		listPool->size--;
+		node = listPool->nodes[listPool->size];
+		listPool->nodes[listPool->size] = NULL;
 	}
 
 	return node;
@@ -108,18 +108,18 @@ void push_ListNode(ListNode* node)
 	if (node == NULL)
 		return;
 	// If the pooling isn't supported then just free the node from memory.
-	else if (pool == NULL)
+	else if (listPool == NULL)
 	{
 		free(node);	
 		return;
 	}
 	// If the pool exists but is filled then exit.
-	else if (pool->size == pool->capacity)
+	else if (listPool->size == listPool->capacity)
 		return;
 
 	node->data = NULL;
 	node->next = NULL;
-	pool->nodes[pool->size++] = node;
+	listPool->nodes[listPool->size++] = node;
 }
 
 
@@ -319,13 +319,15 @@ void list_traverse(List* l, void (*process)(void* item))
 // Clears the list of all data.
 void list_clear(List* l)
 {
-	l->current = l->first;
+	ListNode* node = l->first;
+	ListNode* next;
 	
 	// Remove each node and place it on the pool
-	while (l->current != NULL)
+	while (node != NULL)
 	{
-		push_ListNode(l->current);
-		l->current = l->current->next;
+		next = node->next;
+		push_ListNode(node);
+		node = next;
 	}
 	
 	// Clear all the lists data
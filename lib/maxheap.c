@@ -49,55 +49,55 @@ typedef struct
 
 
 // The pool to use for any Queue's nodes.
-Pool* pool;
+Pool* maxheapPool;
 
 
 // Creates a pool of StackNodes.
 void pool_maxheap(unsigned int capacity)
 {
-	pool = alloc(Pool, 1);
+	maxheapPool = alloc(Pool, 1);
 
-	pool->capacity = capacity;
-	pool->size = 0;
-	pool->nodes = alloc(MaxHeapNode*, capacity);
+	maxheapPool->capacity = capacity;
+	maxheapPool->size = 0;
+	maxheapPool->nodes = alloc(MaxHeapNode*, capacity);
 }
 
 // Destroys the pool of StackNodes.
 void unpool_maxheap()
 {
-	if (pool == NULL)
+	if (maxheapPool == NULL)
 		return;
 	
 	unsigned int i;
-	for (i = 0; i < pool->size; i++)
-		free(pool->nodes[i]);
+	for (i = 0; i < maxheapPool->size; i++)
+		free(maxheapPool->nodes[i]);
 
-	free(pool->nodes);
-	free(pool);
+	free(maxheapPool->nodes);
+	free(maxheapPool);
 
-	pool = NULL;
+	maxheapPool = NULL;
 }
 
 // Returns a node from the pool or allocates a new one.
 MaxHeapNode* pop_MaxHeapNode()
 {
 	// Of pooling isn't supported then just allocate a new one.
-	if (pool == NULL)
+	if (maxheapPool == NULL)
 		return alloc(MaxHeapNode, 1);
 
 	MaxHeapNode* node;
 
 	// If there are none on the pool then allocate a new one
-	if (pool->size == 0)
+	if (maxheapPool->size == 0)
 	{
 		node = alloc(MaxHeapNode, 1);
 	}
 	// If there is one on the pool grab one from the back.
 	else
 	{
-		pool->size--;
-		node = pool->nodes[pool->size];
-		pool->nodes[pool->size] = NULL;
+		maxheapPool->size--;
+		node = maxheapPool->nodes[maxheapPool->size];
+		maxheapPool->nodes[maxheapPool->size] = NULL;
 	}
 
 	return node;
@@ -110,18 +110,18 @@ void push_MaxHeapNode(MaxHeapNode* node)
 	if (node == NULL)
 		return;
 	// If the pooling isn't supported then just free the node from memory.
-	else if (pool == NULL)
+	else if (maxheapPool == NULL)
 	{
 		free(node);	
 		return;
 	}
 	// If the pool exists but is filled then exit.
-	else if (pool->size == pool->capacity)
+	else if (maxheapPool->size == maxheapPool->capacity)
 		return;
 
 	// push the node into the pool.
 	node->data = NULL;
-	pool->nodes[pool->size++] = node;
+	maxheapPool->nodes[maxheapPool->size++] = node;
 }
 
 // Initializes a new maximum heap based on the maximum capacity
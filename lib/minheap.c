@@ -12,11 +12,16 @@
  * value. The operations that can be performed on an array list are:
  * 
  * Add => Add an item to the min heap given a key.
+ * Offer => Adds an item to a full heap only if it beats the lowest key.
  * PeekMax => Returns the item that has the lowest key.
  * PopMax => Removes and returns the item that has the lowest key.
+ * ReplaceMin => Replaces the item that has the lowest key with another.
  * Set => Sets an item with some key.
  * Update => Updates some key with a new key.
  * Exists => Returns true if a given key exists in the tree.
+ * Sort => Sorts the items in the heap by their key.
+ * Merge => Moves all items from one heap into another.
+ * DrainSorted => Removes all items from several heaps in order of key.
  * Traverse => Traverses the list of items using a Breadth-First-Search.
  * Display => Displays the heap structure given a toString method.
  * Clear => Clears all items from the list.
@@ -26,8 +31,10 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "util.h"
+#include "parallel.h"
 #include "minheap.h"
 
 /**
@@ -49,55 +56,55 @@ typedef struct
 
 
 // The pool to use for any Queue's nodes.
-Pool* pool;
+Pool* minheapPool;
 
 
 // Creates a pool of StackNodes.
 void pool_minheap(unsigned int capacity)
 {
-	pool = alloc(Pool, 1);
+	minheapPool = alloc(Pool, 1);
 
-	pool->capacity = capacity;
-	pool->size = 0;
-	pool->nodes = alloc(MinHeapNode*, capacity);
+	minheapPool->capacity = capacity;
+	minheapPool->size = 0;
+	minheapPool->nodes = alloc(MinHeapNode*, capacity);
 }
 
 // Destroys the pool of StackNodes.
 void unpool_minheap()
 {
-	if (pool == NULL)
+	if (minheapPool == NULL)
 		return;
 	
 	unsigned int i;
-	for (i = 0; i < pool->size; i++)
-		free(pool->nodes[i]);
+	for (i = 0; i < minheapPool->size; i++)
+		free(minheapPool->nodes[i]);
 
-	free(pool->nodes);
-	free(pool);
+	free(minheapPool->nodes);
+	free(minheapPool);
 
-	pool = NULL;
+	minheapPool = NULL;
 }
 
 // Returns a node from the pool or allocates a new one.
 MinHeapNode* pop_MinHeapNode()
 {
 	// Of pooling isn't supported then just allocate a new one.
-	if (pool == NULL)
+	if (minheapPool == NULL)
 		return alloc(MinHeapNode, 1);
 
 	MinHeapNode* node;
 
 	// If there are none on the pool then allocate a new one
-	if (pool->size == 0)
+	if (minheapPool->size == 0)
 	{
 		node = alloc(MinHeapNode, 1);
 	}
 	// If there is one on the pool grab one from the back.
 	else
 	{
-		pool->size--;
-		node = pool->nodes[pool->size];
-		pool->nodes[pool->size] = NULL;
+		minheapPool->size--;
+		node = minheapPool->nodes[minheapPool->size];
+		minheapPool->nodes[minheapPool->size] = NULL;
 	}
 
 	return node;
@@ -110,18 +117,21 @@ void push_MinHeapNode(MinHeapNode* node)
 	if (node == NULL)
 		return;
 	// If the pooling isn't supported then just free the node from memory.
-	else if (pool == NULL)
+	else if (minheapPool == NULL)
 	{
 		free(node);	
 		return;
 	}
-	// If the pool exists but is filled then exit.
-	else if (pool->size == pool->capacity)
+	// If the pool exists but is filled then free the node.
+	else if (minheapPool->size == minheapPool->capacity)
+	{
+		free(node);
 		return;
+	}
 
 	// push the node into the pool.
 	node->data = NULL;
-	pool->nodes[pool->size++] = node;
+	minheapPool->nodes[minheapPool->size++] = node;
 }
 
 // Initializes a new minimum heap based on the minimum capacity
@@ -153,18 +163,18 @@ void minheap_heapifyUp(MinHeap* h, unsigned int index)
 	h->nodes[index] = bottom;
 }
 
-// Heapifies from some index down.
-void minheap_heapifyDown(MinHeap* h, unsigned int index)
+// Heapifies from some index down considering only the first 'size' nodes.
+void minheap_siftDown(MinHeap* h, unsigned int index, unsigned int size)
 {
 	unsigned int larger, left, right;
 	MinHeapNode* top = h->nodes[index];
 	
-	while (index < (h->size >> 1))
+	while (index < (size >> 1))
 	{
 		left = (index << 1) | 1;
 		right = left + 1;
 	
-		if (right < h->size && (h->nodes[left]->key > h->nodes[right]->key))
+		if (right < size && (h->nodes[left]->key > h->nodes[right]->key))
 			larger = right;
 		else
 			larger = left;
@@ -178,6 +188,12 @@ void minheap_heapifyDown(MinHeap* h, unsigned int index)
 	h->nodes[index] = top;
 }
 
+// Heapifies from some index down.
+void minheap_heapifyDown(MinHeap* h, unsigned int index)
+{
+	minheap_siftDown(h, index, h->size);
+}
+
 // Finds a node with the specified key with a linear search.
 MinHeapNode* minheap_getNode(MinHeap* h, int key, unsigned int* index)
 {
@@ -219,6 +235,24 @@ void minheap_addf(MinHeap* h, int key, void* item)
 	minheap_add(h, key, item);
 }
 
+// Offers an item to a heap which keeps the items with the highest keys
+// seen so far. If the heap is full and the key doesn't beat the lowest 
+// key in the heap the item is rejected.
+int minheap_offer(MinHeap* h, int key, void* item)
+{
+	if (h->size < h->capacity)
+		return minheap_add(h, key, item);
+
+	// Reject anything that wouldn't make it into the heap with just one
+	// comparison against the top.
+	if (h->size == 0 || key <= h->nodes[0]->key)
+		return false;
+
+	minheap_replaceMin(h, key, item);
+
+	return true;
+}
+
 // Gets the item with the specified key and returns it. If the key isn't
 // found then NULL is returned.
 void* minheap_get(MinHeap* h, int key)
@@ -250,6 +284,27 @@ void* minheap_popMin(MinHeap* h)
 	return item;
 }
 
+// Replaces the item with the minimum key with the given item and heapifies
+// down once, returning the item that was replaced.
+void* minheap_replaceMin(MinHeap* h, int key, void* item)
+{
+	if (h->size == 0)
+	{
+		minheap_addf(h, key, item);
+		return NULL;
+	}
+
+	// Reuse the top node rather then pooling it and popping another.
+	MinHeapNode* top = h->nodes[0];
+	void* replaced = top->data;
+
+	top->key = key;
+	top->data = item;
+	minheap_heapifyDown(h, 0);
+
+	return replaced;
+}
+
 // Returns the item at the top of the min heap without removing it.
 void* minheap_peekMin(MinHeap* h)
 {
@@ -314,6 +369,166 @@ void minheap_resize(MinHeap* h, unsigned int capacity)
 	h->nodes = realloc(h->nodes, void*, capacity);
 }
 
+// Sorts the nodes of the heap in place so they're in ascending order of
+// their keys without allocating any memory.
+void minheap_sort(MinHeap* h)
+{
+	if (h->size < 2)
+		return;
+
+	unsigned int end = h->size - 1;
+	unsigned int start = 0;
+	MinHeapNode* swap;
+
+	// Heap sort moves the lowest key to the back each pass which leaves
+	// the nodes in descending order.
+	while (end > 0)
+	{
+		swap = h->nodes[0];
+		h->nodes[0] = h->nodes[end];
+		h->nodes[end] = swap;
+
+		minheap_siftDown(h, 0, end);
+		end--;
+	}
+
+	// Reverse them so the nodes are ascending and still form a min heap.
+	end = h->size - 1;
+	while (start < end)
+	{
+		swap = h->nodes[start];
+		h->nodes[start] = h->nodes[end];
+		h->nodes[end] = swap;
+
+		start++;
+		end--;
+	}
+}
+
+// Moves all items from the other heap into the given heap leaving the 
+// other heap empty.
+void minheap_merge(MinHeap* h, MinHeap* other)
+{
+	if (other->size == 0)
+		return;
+
+	unsigned int total = h->size + other->size;
+	unsigned int i;
+
+	if (total > h->capacity)
+		minheap_resize(h, total);
+
+	memcpy(h->nodes + h->size, other->nodes, other->size * sizeof(MinHeapNode*));
+
+	// Adding a few items to a large heap is cheaper one at a time, otherwise 
+	// rebuild the whole heap from the bottom up in linear time.
+	if (other->size * (ilog2(total) + 1) < total)
+	{
+		for (i = h->size; i < total; i++)
+			minheap_heapifyUp(h, i);
+
+		h->size = total;
+	}
+	else
+	{
+		h->size = total;
+
+		for (i = total >> 1; i > 0; i--)
+			minheap_heapifyDown(h, i - 1);
+	}
+
+	other->size = 0;
+}
+
+// The parallel loop body which sorts a range of the heaps.
+void minheap_sortRange(unsigned int start, unsigned int end, void* heaps)
+{
+	unsigned int i;
+
+	for (i = start; i < end; i++)
+		minheap_sort(((MinHeap**)heaps)[i]);
+}
+
+// Returns the key of the next item to drain from a sorted heap.
+int minheap_drainKey(MinHeap** heaps, unsigned int* position, unsigned int heap)
+{
+	return heaps[heap]->nodes[position[heap]]->key;
+}
+
+// Heapifies down the heap of heap indices used to merge sorted heaps.
+void minheap_drainDown(MinHeap** heaps, unsigned int* position, unsigned int* order, 
+							  unsigned int size, unsigned int index)
+{
+	unsigned int child;
+	unsigned int top = order[index];
+	int key = minheap_drainKey(heaps, position, top);
+
+	while ((child = (index << 1) | 1) < size)
+	{
+		if (child + 1 < size && minheap_drainKey(heaps, position, order[child + 1]) <
+										minheap_drainKey(heaps, position, order[child]))
+			child++;
+
+		if (key <= minheap_drainKey(heaps, position, order[child]))
+			break;
+
+		order[index] = order[child];
+		index = child;
+	}
+	order[index] = top;
+}
+
+// Removes every item from several heaps calling the method 'process' on
+// each item in ascending order of key across all heaps.
+void minheap_drainSorted(MinHeap** heaps, unsigned int count, void (*process)(void* item))
+{
+	if (count == 0)
+		return;
+
+	// Sort the heaps with one thread per processor, each claiming the next
+	// unsorted heap until none are left.
+	parallel_for(count, 1, 0, &minheap_sortRange, heaps);
+
+	unsigned int i;
+
+	// Merge the sorted heaps using a small heap of the heaps themselves 
+	// ordered by the key of the next item in each.
+	unsigned int* position = calloc(unsigned int, count);
+	unsigned int* order = alloc(unsigned int, count);
+	unsigned int size = 0;
+	unsigned int next;
+
+	for (i = 0; i < count; i++)
+		if (heaps[i]->size > 0)
+			order[size++] = i;
+
+	for (i = size >> 1; i > 0; i--)
+		minheap_drainDown(heaps, position, order, size, i - 1);
+
+	while (size > 0)
+	{
+		next = order[0];
+		process(heaps[next]->nodes[position[next]]->data);
+
+		// Move the heap on to its next item, or drop it if it's exhausted.
+		if (++position[next] == heaps[next]->size)
+		{
+			order[0] = order[--size];
+
+			if (size == 0)
+				break;
+		}
+
+		minheap_drainDown(heaps, position, order, size, 0);
+	}
+
+	free(position);
+	free(order);
+
+	for (i = 0; i < count; i++)
+		minheap_clear(heaps[i]);
+}
+
 // Does a breadth first search on the heap and for each item traversed 
 // the method 'process' is called passing in that item.
 void minheap_traverseBreadth(MinHeap* h, void (*process)(void* item))
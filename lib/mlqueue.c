@@ -0,0 +1,217 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * A queue containing generic data at several priority levels which is
+ * polled using deficit round robin. The operations that can be performed
+ * on a multi-level queue are:
+ * 
+ * Offer => Adds an item to the end of a level.
+ * Poll => Removes and returns the next item by deficit round robin.
+ * Peek => Returns the item that would be polled next.
+ * SetWeight => Changes the number of items polled from a level each round.
+ * LevelSize => Returns the number of items at a level.
+ * ResetStats => Resets the statistics of every level.
+ * Clear => Clears all items from the queue.
+ * Free => Frees the queue from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+#include "util.h"
+#include "mlqueue.h"
+
+// Starts a new round, giving every level with items its full weight.
+void mlqueue_startRound(MultiLevelQueue* q)
+{
+	unsigned int waiting = q->waiting;
+	unsigned int level;
+
+	while (waiting != 0)
+	{
+		level = __builtin_ctz(waiting);
+		waiting &= waiting - 1;
+
+		q->levels[level].deficit = q->levels[level].weight;
+	}
+
+	q->credited = q->waiting;
+}
+
+// Returns the level polled next, or -1 if the queue is empty. A new round
+// is only started when the queue is polled, so peeking changes nothing.
+int mlqueue_next(MultiLevelQueue* q)
+{
+	unsigned int ready = q->waiting & q->credited;
+
+	// When no level has credit left a new round starts with every level
+	// that has items, so the first of those is next.
+	if (ready == 0)
+		ready = q->waiting;
+	if (ready == 0)
+		return -1;
+
+	return __builtin_ctz(ready);
+}
+
+// Returns an empty multi-level queue allocated to the heap.
+MultiLevelQueue* newMultiLevelQueue(unsigned int levels, unsigned int* weights)
+{
+	MultiLevelQueue* q = alloc(MultiLevelQueue, 1);
+	unsigned int i;
+
+	levels = max(1, min(levels, MLQUEUE_MAX_LEVELS));
+
+	q->levels = alloc(MultiLevelQueueLevel, levels);
+	q->levelCount = levels;
+	q->size = 0;
+	q->waiting = 0;
+	q->credited = 0;
+
+	for (i = 0; i < levels; i++)
+	{
+		q->levels[i].queue = newArrayQueue(16);
+		q->levels[i].weight = (weights == NULL ? 1 : max(1, weights[i]));
+		q->levels[i].deficit = 0;
+		q->levels[i].offered = 0;
+		q->levels[i].polled = 0;
+		q->levels[i].peak = 0;
+	}
+
+	return q;
+}
+
+// Adds an item to the end of a level of the queue.
+int mlqueue_offer(MultiLevelQueue* q, unsigned int level, void* item)
+{
+	if (level >= q->levelCount || item == NULL)
+		return false;
+
+	MultiLevelQueueLevel* l = &q->levels[level];
+
+	aqueue_offerf(l->queue, item);
+
+	// A level that had no items waits for the next round to be credited,
+	// so a level can't be emptied and refilled to be polled past its weight.
+	q->waiting |= (1u << level);
+	q->size++;
+
+	l->offered++;
+	l->peak = max(l->peak, (unsigned int)l->queue->size);
+
+	return true;
+}
+
+// Removes and returns the next item by deficit round robin.
+void* mlqueue_poll(MultiLevelQueue* q)
+{
+	if (q->size == 0)
+		return NULL;
+
+	if ((q->waiting & q->credited) == 0)
+		mlqueue_startRound(q);
+
+	unsigned int level = __builtin_ctz(q->waiting & q->credited);
+	unsigned int bit = (1u << level);
+	MultiLevelQueueLevel* l = &q->levels[level];
+	void* item = aqueue_poll(l->queue);
+
+	q->size--;
+	l->polled++;
+	l->deficit--;
+
+	// An emptied level gives up the rest of its round.
+	if (aqueue_isEmpty(l->queue))
+	{
+		l->deficit = 0;
+		q->waiting &= ~bit;
+	}
+
+	if (l->deficit == 0)
+		q->credited &= ~bit;
+
+	return item;
+}
+
+// Returns the item that would be polled next.
+void* mlqueue_peek(MultiLevelQueue* q)
+{
+	int level = mlqueue_next(q);
+
+	if (level == -1)
+		return NULL;
+
+	return aqueue_peek(q->levels[level].queue);
+}
+
+// Changes the number of items polled from a level in each round.
+void mlqueue_setWeight(MultiLevelQueue* q, unsigned int level, unsigned int weight)
+{
+	if (level < q->levelCount)
+		q->levels[level].weight = max(1, weight);
+}
+
+// Returns the number of items at a level.
+unsigned int mlqueue_levelSize(MultiLevelQueue* q, unsigned int level)
+{
+	if (level >= q->levelCount)
+		return 0;
+
+	return q->levels[level].queue->size;
+}
+
+// Returns true if the queue has no items at any level.
+int mlqueue_isEmpty(MultiLevelQueue* q)
+{
+	return (q->size == 0);
+}
+
+// Resets the statistics of every level.
+void mlqueue_resetStats(MultiLevelQueue* q)
+{
+	unsigned int i;
+
+	for (i = 0; i < q->levelCount; i++)
+	{
+		q->levels[i].offered = 0;
+		q->levels[i].polled = 0;
+		q->levels[i].peak = q->levels[i].queue->size;
+	}
+}
+
+// Clears every level of the queue of all items.
+void mlqueue_clear(MultiLevelQueue* q)
+{
+	unsigned int i;
+
+	for (i = 0; i < q->levelCount; i++)
+	{
+		aqueue_clear(q->levels[i].queue);
+		q->levels[i].deficit = 0;
+	}
+
+	q->size = 0;
+	q->waiting = 0;
+	q->credited = 0;
+}
+
+// Removes the queue completely from memory.
+void mlqueue_free(MultiLevelQueue* q)
+{
+	if (q == NULL)
+		return;
+
+	unsigned int i;
+
+	for (i = 0; i < q->levelCount; i++)
+		aqueue_free(q->levels[i].queue);
+
+	free(q->levels);
+	free(q);
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * A bounded array based queue containing generic data which any number of
+ * threads can offer to and poll from at the same time. The operations that
+ * can be performed on an mpmc queue are:
+ * 
+ * TryOffer => Adds an item to the end of the queue if it's not full.
+ * TryPoll => Removes and returns the item at the front of the queue if there is one.
+ * Offer => Adds an item to the end of the queue, waiting while it's full.
+ * Poll => Removes and returns the item at the front of the queue, waiting while it's empty.
+ * Size => Returns the number of items in the queue.
+ * Free => Frees the queue from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+// Waiting threads sleep on a futex where available.
+#ifdef __linux__
+#define MPMC_FUTEX
+#endif
+
+#ifdef MPMC_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <sched.h>
+#endif
+
+#include "util.h"
+#include "mpmcqueue.h"
+
+// Sleeps while the event still has the value seen.
+void mpmc_wait(atomic_uint* event, unsigned int seen)
+{
+#ifdef MPMC_FUTEX
+	syscall(SYS_futex, (unsigned int*)event, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+#else
+	if (atomic_load_explicit(event, memory_order_acquire) == seen)
+		sched_yield();
+#endif
+}
+
+// Bumps the event and wakes a thread waiting on it, if any are waiting.
+void mpmc_wake(atomic_uint* event, atomic_uint* waiters)
+{
+	// Pairs with the fence in mpmc_sleep so either the waiter sees the
+	// change to the queue or this sees the waiter.
+	atomic_thread_fence(memory_order_seq_cst);
+
+	if (atomic_load_explicit(waiters, memory_order_relaxed) == 0)
+		return;
+
+	atomic_fetch_add_explicit(event, 1, memory_order_release);
+
+#ifdef MPMC_FUTEX
+	syscall(SYS_futex, (unsigned int*)event, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+}
+
+// Registers as a waiter on the event, tries the operation once more, and
+// sleeps if it still can't finish. Returns true if the retry succeeded.
+int mpmc_sleep(MpmcQueue* q, atomic_uint* event, atomic_uint* waiters, void** item, int polling)
+{
+	unsigned int seen = atomic_load_explicit(event, memory_order_acquire);
+	int done;
+
+	atomic_fetch_add_explicit(waiters, 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+
+	if (polling)
+		done = ((*item = mpmc_tryPoll(q)) != NULL);
+	else
+		done = mpmc_tryOffer(q, *item);
+
+	if (!done)
+		mpmc_wait(event, seen);
+
+	atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+
+	return done;
+}
+
+// Returns an empty mpmc queue allocated to the heap.
+MpmcQueue* newMpmcQueue(unsigned int capacity)
+{
+	MpmcQueue* q;
+
+	if (posix_memalign((void**)&q, CACHE_LINE, sizeof(MpmcQueue)) != 0)
+		return NULL;
+
+	// Determine the next size thats a power of 2
+	unsigned int actual = 2;
+	while (actual < capacity)
+		actual <<= 1;
+
+	atomic_init(&q->tail, 0);
+	atomic_init(&q->head, 0);
+	atomic_init(&q->itemEvent, 0);
+	atomic_init(&q->itemWaiters, 0);
+	atomic_init(&q->slotEvent, 0);
+	atomic_init(&q->slotWaiters, 0);
+	q->capacity = actual;
+	q->mask = actual - 1;
+	q->slots = alloc(MpmcSlot, actual);
+
+	unsigned int i;
+	for (i = 0; i < actual; i++)
+	{
+		atomic_init(&q->slots[i].sequence, i);
+		q->slots[i].data = NULL;
+	}
+
+	return q;
+}
+
+// Adds an item to the end of the queue if it's not full.
+int mpmc_tryOffer(MpmcQueue* q, void* item)
+{
+	unsigned int position = atomic_load_explicit(&q->tail, memory_order_relaxed);
+	MpmcSlot* slot;
+
+	for (;;)
+	{
+		slot = &q->slots[position & q->mask];
+
+		unsigned int sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		int turn = (int)(sequence - position);
+
+		// The slot is free for this position, try to claim the position.
+		if (turn == 0)
+		{
+			if (atomic_compare_exchange_weak_explicit(&q->tail, &position, position + 1,
+				memory_order_relaxed, memory_order_relaxed))
+				break;
+		}
+		// The slot still holds the item from a lap ago, the queue is full.
+		else if (turn < 0)
+		{
+			return false;
+		}
+		// Another thread claimed the position, catch up.
+		else
+		{
+			position = atomic_load_explicit(&q->tail, memory_order_relaxed);
+		}
+	}
+
+	slot->data = item;
+	atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+
+	mpmc_wake(&q->itemEvent, &q->itemWaiters);
+
+	return true;
+}
+
+// Removes and returns the item at the front of the queue if there is one.
+void* mpmc_tryPoll(MpmcQueue* q)
+{
+	unsigned int position = atomic_load_explicit(&q->head, memory_order_relaxed);
+	MpmcSlot* slot;
+
+	for (;;)
+	{
+		slot = &q->slots[position & q->mask];
+
+		unsigned int sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		int turn = (int)(sequence - (position + 1));
+
+		// The slot is filled for this position, try to claim the position.
+		if (turn == 0)
+		{
+			if (atomic_compare_exchange_weak_explicit(&q->head, &position, position + 1,
+				memory_order_relaxed, memory_order_relaxed))
+				break;
+		}
+		// The slot hasn't been filled yet, the queue is empty.
+		else if (turn < 0)
+		{
+			return NULL;
+		}
+		// Another thread claimed the position, catch up.
+		else
+		{
+			position = atomic_load_explicit(&q->head, memory_order_relaxed);
+		}
+	}
+
+	void* item = slot->data;
+
+	// Free the slot for the offer one lap ahead.
+	atomic_store_explicit(&slot->sequence, position + q->capacity, memory_order_release);
+
+	mpmc_wake(&q->slotEvent, &q->slotWaiters);
+
+	return item;
+}
+
+// Adds an item to the end of the queue, waiting while it's full.
+void mpmc_offer(MpmcQueue* q, void* item)
+{
+	while (!mpmc_tryOffer(q, item))
+		if (mpmc_sleep(q, &q->slotEvent, &q->slotWaiters, &item, false))
+			return;
+}
+
+// Removes and returns the item at the front of the queue, waiting while
+// it's empty.
+void* mpmc_poll(MpmcQueue* q)
+{
+	void* item;
+
+	while ((item = mpmc_tryPoll(q)) == NULL)
+		if (mpmc_sleep(q, &q->itemEvent, &q->itemWaiters, &item, true))
+			break;
+
+	return item;
+}
+
+// Returns the number of items in the queue.
+unsigned int mpmc_size(MpmcQueue* q)
+{
+	unsigned int head = atomic_load_explicit(&q->head, memory_order_acquire);
+	unsigned int tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+	int size = (int)(tail - head);
+
+	return (unsigned int)min(max(size, 0), (int)q->capacity);
+}
+
+// Returns true if the queue has no items.
+int mpmc_isEmpty(MpmcQueue* q)
+{
+	return (mpmc_size(q) == 0);
+}
+
+// Removes the queue completely from memory.
+void mpmc_free(MpmcQueue* q)
+{
+	if (q == NULL)
+		return;
+
+	free(q->slots);
+	free(q);
+}
\ No newline at end of file
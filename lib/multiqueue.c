@@ -0,0 +1,319 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * A concurrent priority queue made up of several min heaps each protected
+ * by its own lock. Items are added to a random heap and popped from the
+ * better of two randomly chosen heaps, so threads rarely contend on the
+ * same lock. The order items are popped in is relaxed: the item popped is
+ * close to but not always the item with the lowest key. The operations
+ * that can be performed on a multi queue are:
+ *
+ * Add => Add an item to the multi queue given a key.
+ * PeekMin => Returns an item that has one of the lowest keys.
+ * PopMin => Removes and returns an item that has one of the lowest keys.
+ * Clear => Clears all items from the multi queue.
+ * Free => Frees the multi queue from memory.
+ *
+ * @author Philip Diffenderfer
+ */
+
+#include <limits.h>
+
+#include "util.h"
+#include "multiqueue.h"
+
+// The top of an empty heap, which is larger than any key.
+#define MULTIQUEUE_EMPTY	LLONG_MAX
+
+// The random state of the current thread used to pick heaps.
+_Thread_local unsigned int multiqueueSeed;
+
+// Returns a random heap index using a per-thread xorshift generator.
+unsigned int multiqueue_random(MultiQueue* q)
+{
+	unsigned int x = multiqueueSeed;
+
+	// Seed each thread differently based on where its stack lives.
+	if (x == 0)
+		x = (unsigned int)((size_t)&x >> 4) | 1;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	multiqueueSeed = x;
+
+	return x % q->count;
+}
+
+// Returns the key on top of the heap without taking its lock.
+long long multiqueue_top(MultiQueueHeap* h)
+{
+	return atomic_load_explicit(&h->top, memory_order_relaxed);
+}
+
+// Publishes the key on top of the heap for other threads to read.
+void multiqueue_updateTop(MultiQueueHeap* h)
+{
+	long long top = (h->size == 0 ? MULTIQUEUE_EMPTY : h->entries[0].key);
+
+	atomic_store_explicit(&h->top, top, memory_order_relaxed);
+}
+
+// Adds an entry to a locked heap and heapifies up.
+void multiqueue_push(MultiQueueHeap* h, int key, void* item)
+{
+	if (h->size == h->capacity)
+	{
+		h->capacity <<= 1;
+		h->entries = realloc(h->entries, MultiQueueEntry, h->capacity);
+	}
+
+	unsigned int index = h->size++;
+	unsigned int parent;
+
+	while (index > 0)
+	{
+		parent = (index - 1) >> 1;
+
+		if (h->entries[parent].key <= key)
+			break;
+
+		h->entries[index] = h->entries[parent];
+		index = parent;
+	}
+
+	h->entries[index].key = key;
+	h->entries[index].data = item;
+
+	multiqueue_updateTop(h);
+}
+
+// Removes the top entry of a locked heap that isn't empty and heapifies down.
+void* multiqueue_pop(MultiQueueHeap* h)
+{
+	void* item = h->entries[0].data;
+
+	h->size--;
+
+	MultiQueueEntry bottom = h->entries[h->size];
+	unsigned int index = 0;
+	unsigned int smaller, left, right;
+
+	while (index < (h->size >> 1))
+	{
+		left = (index << 1) | 1;
+		right = left + 1;
+
+		if (right < h->size && h->entries[right].key < h->entries[left].key)
+			smaller = right;
+		else
+			smaller = left;
+
+		if (bottom.key <= h->entries[smaller].key)
+			break;
+
+		h->entries[index] = h->entries[smaller];
+		index = smaller;
+	}
+
+	if (h->size > 0)
+		h->entries[index] = bottom;
+
+	multiqueue_updateTop(h);
+
+	return item;
+}
+
+// Returns a new multi queue with no items.
+MultiQueue* newMultiQueue(unsigned int queues, unsigned int capacity)
+{
+	MultiQueue* q = alloc(MultiQueue, 1);
+
+	q->count = max(queues, 1);
+	q->heaps = alloc(MultiQueueHeap*, q->count);
+	atomic_init(&q->size, 0);
+
+	// Each heap gets its own cache lines so the locks of different heaps
+	// aren't bounced between threads.
+	size_t bytes = (sizeof(MultiQueueHeap) + CACHE_LINE - 1) & ~(size_t)(CACHE_LINE - 1);
+	unsigned int i;
+	void* memory;
+
+	for (i = 0; i < q->count; i++)
+	{
+		if (posix_memalign(&memory, CACHE_LINE, bytes) != 0)
+			memory = alloc(MultiQueueHeap, 1);
+
+		MultiQueueHeap* h = memory;
+		pthread_mutex_init(&h->lock, NULL);
+		atomic_init(&h->top, MULTIQUEUE_EMPTY);
+		h->size = 0;
+		h->capacity = max(capacity, 1);
+		h->entries = alloc(MultiQueueEntry, h->capacity);
+
+		q->heaps[i] = h;
+	}
+
+	return q;
+}
+
+// Adds an item to a random heap in the multi queue.
+void multiqueue_add(MultiQueue* q, int key, void* item)
+{
+	MultiQueueHeap* h;
+
+	// Keep picking heaps until one isn't locked by another thread.
+	do
+	{
+		h = q->heaps[multiqueue_random(q)];
+	}
+	while (pthread_mutex_trylock(&h->lock) != 0);
+
+	multiqueue_push(h, key, item);
+
+	// Count the item while the heap is locked, so a pop of it can't take
+	// the size below zero.
+	atomic_fetch_add(&q->size, 1);
+	pthread_mutex_unlock(&h->lock);
+}
+
+// Removes an item with one of the lowest keys from the multi queue.
+void* multiqueue_popMin(MultiQueue* q)
+{
+	MultiQueueHeap* a;
+	MultiQueueHeap* b;
+	void* item;
+	unsigned int attempts, i;
+
+	// Pick the better of two random heaps, giving up on the random choice
+	// if the heaps chosen keep turning out to be empty or locked.
+	for (attempts = 0; attempts < q->count; attempts++)
+	{
+		if (atomic_load(&q->size) == 0)
+			return NULL;
+
+		a = q->heaps[multiqueue_random(q)];
+		b = q->heaps[multiqueue_random(q)];
+
+		if (multiqueue_top(b) < multiqueue_top(a))
+			a = b;
+
+		if (multiqueue_top(a) == MULTIQUEUE_EMPTY)
+			continue;
+
+		if (pthread_mutex_trylock(&a->lock) != 0)
+			continue;
+
+		if (a->size == 0)
+		{
+			pthread_mutex_unlock(&a->lock);
+			continue;
+		}
+
+		item = multiqueue_pop(a);
+		pthread_mutex_unlock(&a->lock);
+		atomic_fetch_sub(&q->size, 1);
+
+		return item;
+	}
+
+	// Fall back to visiting every heap in turn.
+	for (i = 0; i < q->count; i++)
+	{
+		a = q->heaps[i];
+
+		if (multiqueue_top(a) == MULTIQUEUE_EMPTY)
+			continue;
+
+		pthread_mutex_lock(&a->lock);
+
+		if (a->size > 0)
+		{
+			item = multiqueue_pop(a);
+			pthread_mutex_unlock(&a->lock);
+			atomic_fetch_sub(&q->size, 1);
+
+			return item;
+		}
+
+		pthread_mutex_unlock(&a->lock);
+	}
+
+	return NULL;
+}
+
+// Returns the item with the lowest key on top of any heap without removing it.
+void* multiqueue_peekMin(MultiQueue* q)
+{
+	MultiQueueHeap* best = NULL;
+	long long bestTop = MULTIQUEUE_EMPTY;
+	long long top;
+	unsigned int i;
+
+	for (i = 0; i < q->count; i++)
+	{
+		top = multiqueue_top(q->heaps[i]);
+
+		if (top < bestTop)
+		{
+			best = q->heaps[i];
+			bestTop = top;
+		}
+	}
+
+	if (best == NULL)
+		return NULL;
+
+	void* item = NULL;
+
+	pthread_mutex_lock(&best->lock);
+	if (best->size > 0)
+		item = best->entries[0].data;
+	pthread_mutex_unlock(&best->lock);
+
+	return item;
+}
+
+// Returns true if the multi queue has no items in it.
+int multiqueue_isEmpty(MultiQueue* q)
+{
+	return (atomic_load(&q->size) == 0);
+}
+
+// Clears the multi queue of all items.
+void multiqueue_clear(MultiQueue* q)
+{
+	unsigned int i;
+	for (i = 0; i < q->count; i++)
+	{
+		q->heaps[i]->size = 0;
+		multiqueue_updateTop(q->heaps[i]);
+	}
+
+	atomic_store(&q->size, 0);
+}
+
+// Clears the multi queue and frees it from memory.
+void multiqueue_free(MultiQueue* q)
+{
+	if (q == NULL)
+		return;
+
+	unsigned int i;
+	for (i = 0; i < q->count; i++)
+	{
+		pthread_mutex_destroy(&q->heaps[i]->lock);
+		free(q->heaps[i]->entries);
+		free(q->heaps[i]);
+	}
+
+	free(q->heaps);
+	free(q);
+}
\ No newline at end of file
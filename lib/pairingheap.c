@@ -0,0 +1,502 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * This is a pairing heap containing generic data which is ordered by some
+ * key value. Unlike the array heaps two pairing heaps can be melded in
+ * constant time and the key of a node can be decreased in constant time.
+ * The operations that can be performed on a pairing heap are:
+ *
+ * Add => Add an item to the pairing heap given a key.
+ * PeekMin => Returns the item that has the lowest key.
+ * PopMin => Removes and returns the item that has the lowest key.
+ * Set => Sets an item with some key.
+ * Update => Updates some key with a new key.
+ * DecreaseKey => Decreases the key of a node returned from AddNode.
+ * Meld => Moves all items from one pairing heap into another.
+ * Traverse => Traverses the heap of items in no specific order.
+ * Clear => Clears all items from the heap.
+ * Free => Frees the heap from memory.
+ *
+ * @author Philip Diffenderfer
+ */
+
+#include "util.h"
+#include "pairingheap.h"
+
+/**
+ * A pool is a stack like structure that can pop and push PairingHeapNodes.
+ * If there are no PairingHeapNodes to pop and a request is made then the
+ * pool will allocate a PairingHeapNode on the spot. A pool is restricted
+ * by a maximum capcity.
+ */
+typedef struct
+{
+	// The current number of nodes available for unpooling.
+	unsigned int size;
+	// The maximum number of nodes that can be pooled.
+	unsigned int capacity;
+	// The array of node pointers for pooling/unpooling.
+	PairingHeapNode** nodes;
+
+} Pool;
+
+
+// The pool to use for any PairingHeap's nodes.
+Pool* pairingPool;
+
+
+// Creates a pool of PairingHeapNodes.
+void pool_pairingheap(unsigned int capacity)
+{
+	pairingPool = alloc(Pool, 1);
+
+	pairingPool->capacity = capacity;
+	pairingPool->size = 0;
+	pairingPool->nodes = alloc(PairingHeapNode*, capacity);
+}
+
+// Destroys the pool of PairingHeapNodes.
+void unpool_pairingheap()
+{
+	if (pairingPool == NULL)
+		return;
+
+	unsigned int i;
+	for (i = 0; i < pairingPool->size; i++)
+		free(pairingPool->nodes[i]);
+
+	free(pairingPool->nodes);
+	free(pairingPool);
+
+	pairingPool = NULL;
+}
+
+// Returns a node from the pool or allocates a new one.
+PairingHeapNode* pop_PairingHeapNode()
+{
+	// If pooling isn't supported then just allocate a new one.
+	if (pairingPool == NULL)
+		return alloc(PairingHeapNode, 1);
+
+	PairingHeapNode* node;
+
+	// If there are none on the pool then allocate a new one
+	if (pairingPool->size == 0)
+	{
+		node = alloc(PairingHeapNode, 1);
+	}
+	// If there is one on the pool grab one from the back.
+	else
+	{
+		pairingPool->size--;
+		node = pairingPool->nodes[pairingPool->size];
+		pairingPool->nodes[pairingPool->size] = NULL;
+	}
+
+	return node;
+}
+
+// Puts the node on the pool if there is space.
+void push_PairingHeapNode(PairingHeapNode* node)
+{
+	// If the node passed in is null just exit
+	if (node == NULL)
+		return;
+	// If the pooling isn't supported then just free the node from memory.
+	else if (pairingPool == NULL)
+	{
+		free(node);
+		return;
+	}
+	// If the pool exists but is filled then free the node.
+	else if (pairingPool->size == pairingPool->capacity)
+	{
+		free(node);
+		return;
+	}
+
+	// push the node into the pool.
+	node->data = NULL;
+	node->child = NULL;
+	node->sibling = NULL;
+	node->previous = NULL;
+	pairingPool->nodes[pairingPool->size++] = node;
+}
+
+// Links two subtrees together making the one with the larger key the
+// first child of the other, and returns the new subtree.
+PairingHeapNode* pairingheap_link(PairingHeapNode* a, PairingHeapNode* b)
+{
+	if (b->key < a->key)
+	{
+		PairingHeapNode* t = a;
+		a = b;
+		b = t;
+	}
+
+	b->previous = a;
+	b->sibling = a->child;
+	if (a->child != NULL)
+		a->child->previous = b;
+	a->child = b;
+
+	a->sibling = NULL;
+	a->previous = NULL;
+
+	return a;
+}
+
+// Detaches a node and its subtree from its parent and siblings.
+void pairingheap_cut(PairingHeapNode* node)
+{
+	if (node->previous->child == node)
+		node->previous->child = node->sibling;
+	else
+		node->previous->sibling = node->sibling;
+
+	if (node->sibling != NULL)
+		node->sibling->previous = node->previous;
+
+	node->sibling = NULL;
+	node->previous = NULL;
+}
+
+// Combines a list of siblings into one subtree by pairing them up from
+// left to right and then linking the pairs from right to left.
+PairingHeapNode* pairingheap_combine(PairingHeapNode* first)
+{
+	if (first == NULL)
+		return NULL;
+
+	PairingHeapNode* pairs = NULL;
+	PairingHeapNode* node = first;
+	PairingHeapNode* next;
+	PairingHeapNode* pair;
+
+	// Pair up the siblings, keeping the pairs in reverse order.
+	while (node != NULL)
+	{
+		if (node->sibling == NULL)
+		{
+			next = NULL;
+			pair = node;
+			pair->previous = NULL;
+		}
+		else
+		{
+			next = node->sibling->sibling;
+			pair = pairingheap_link(node, node->sibling);
+		}
+
+		pair->sibling = pairs;
+		pairs = pair;
+		node = next;
+	}
+
+	// Link the pairs together starting with the right-most pair.
+	PairingHeapNode* root = pairs;
+	pairs = pairs->sibling;
+	root->sibling = NULL;
+
+	while (pairs != NULL)
+	{
+		next = pairs->sibling;
+		pairs->sibling = NULL;
+		root = pairingheap_link(root, pairs);
+		pairs = next;
+	}
+
+	return root;
+}
+
+// Returns the parent of a node that isn't the root.
+PairingHeapNode* pairingheap_parent(PairingHeapNode* node)
+{
+	while (node->previous->child != node)
+		node = node->previous;
+
+	return node->previous;
+}
+
+// Finds a node with the specified key by walking the tree without recursion.
+PairingHeapNode* pairingheap_getNode(PairingHeap* h, int key)
+{
+	PairingHeapNode* node = h->root;
+
+	while (node != NULL)
+	{
+		if (node->key == key)
+			return node;
+
+		// Go down to the children first, otherwise over to the next sibling
+		// climbing back up until a node with a sibling is found.
+		if (node->child != NULL)
+		{
+			node = node->child;
+		}
+		else
+		{
+			while (node != h->root && node->sibling == NULL)
+				node = pairingheap_parent(node);
+
+			node = (node == h->root ? NULL : node->sibling);
+		}
+	}
+
+	return NULL;
+}
+
+// Returns a new pairing heap with no items.
+PairingHeap* newPairingHeap()
+{
+	PairingHeap* h = alloc(PairingHeap, 1);
+
+	h->size = 0;
+	h->root = NULL;
+
+	return h;
+}
+
+// Adds to the pairing heap.
+int pairingheap_add(PairingHeap* h, int key, void* item)
+{
+	pairingheap_addNode(h, key, item);
+
+	return true;
+}
+
+// Adds to the pairing heap and returns the node holding the item.
+PairingHeapNode* pairingheap_addNode(PairingHeap* h, int key, void* item)
+{
+	PairingHeapNode* node = pop_PairingHeapNode();
+	node->data = item;
+	node->key = key;
+	node->child = NULL;
+	node->sibling = NULL;
+	node->previous = NULL;
+
+	if (h->root == NULL)
+		h->root = node;
+	else
+		h->root = pairingheap_link(h->root, node);
+
+	h->size++;
+
+	return node;
+}
+
+// Gets the item with the specified key and returns it.
+void* pairingheap_get(PairingHeap* h, int key)
+{
+	PairingHeapNode* node = pairingheap_getNode(h, key);
+
+	if (node == NULL)
+		return NULL;
+
+	return node->data;
+}
+
+// Removes the item with the minimum key from the top of the heap.
+void* pairingheap_popMin(PairingHeap* h)
+{
+	if (h->root == NULL)
+		return NULL;
+
+	PairingHeapNode* root = h->root;
+	void* item = root->data;
+
+	h->root = pairingheap_combine(root->child);
+	h->size--;
+
+	push_PairingHeapNode(root);
+
+	return item;
+}
+
+// Returns the item at the top of the pairing heap without removing it.
+void* pairingheap_peekMin(PairingHeap* h)
+{
+	if (h->root == NULL)
+		return NULL;
+
+	return h->root->data;
+}
+
+// Sets the item with the specified key.
+int pairingheap_set(PairingHeap* h, int key, void* item)
+{
+	PairingHeapNode* node = pairingheap_getNode(h, key);
+
+	if (node == NULL)
+		return false;
+
+	node->data = item;
+
+	return true;
+}
+
+// Updates an item's key on the heap with a new key.
+int pairingheap_update(PairingHeap* h, int oldKey, int newKey)
+{
+	PairingHeapNode* node = pairingheap_getNode(h, oldKey);
+
+	if (node == NULL)
+		return false;
+
+	if (newKey <= oldKey)
+		return pairingheap_decreaseKey(h, node, newKey);
+
+	// Increasing a key means its children may now belong above it, so take
+	// the node out by itself and put the node and its children back.
+	PairingHeapNode* children;
+
+	if (node == h->root)
+	{
+		h->root = NULL;
+	}
+	else
+	{
+		pairingheap_cut(node);
+	}
+
+	children = pairingheap_combine(node->child);
+	node->child = NULL;
+	node->key = newKey;
+
+	h->root = (h->root == NULL ? node : pairingheap_link(h->root, node));
+	if (children != NULL)
+		h->root = pairingheap_link(h->root, children);
+
+	return true;
+}
+
+// Decreases the key of a node in the heap.
+int pairingheap_decreaseKey(PairingHeap* h, PairingHeapNode* node, int key)
+{
+	if (key > node->key)
+		return false;
+
+	node->key = key;
+
+	if (node != h->root)
+	{
+		pairingheap_cut(node);
+		h->root = pairingheap_link(h->root, node);
+	}
+
+	return true;
+}
+
+// Removes a node from anywhere in the heap and returns its item.
+void* pairingheap_removeNode(PairingHeap* h, PairingHeapNode* node)
+{
+	if (node != h->root)
+	{
+		pairingheap_cut(node);
+
+		// Hoist the node above the root so it can be popped.
+		PairingHeapNode* root = h->root;
+		root->previous = node;
+		root->sibling = node->child;
+		if (node->child != NULL)
+			node->child->previous = root;
+		node->child = root;
+		h->root = node;
+	}
+
+	return pairingheap_popMin(h);
+}
+
+// Moves all items from the other heap into the given heap.
+void pairingheap_meld(PairingHeap* h, PairingHeap* other)
+{
+	if (other->root == NULL)
+		return;
+
+	if (h->root == NULL)
+		h->root = other->root;
+	else
+		h->root = pairingheap_link(h->root, other->root);
+
+	h->size += other->size;
+
+	other->root = NULL;
+	other->size = 0;
+}
+
+// Returns true if the pairing heap has no items in it.
+int pairingheap_isEmpty(PairingHeap* h)
+{
+	return (h->size == 0);
+}
+
+// Traverses the heap calling 'process' on each item.
+void pairingheap_traverse(PairingHeap* h, void (*process)(void* item))
+{
+	PairingHeapNode* node = h->root;
+
+	while (node != NULL)
+	{
+		process(node->data);
+
+		if (node->child != NULL)
+		{
+			node = node->child;
+		}
+		else
+		{
+			while (node != h->root && node->sibling == NULL)
+				node = pairingheap_parent(node);
+
+			node = (node == h->root ? NULL : node->sibling);
+		}
+	}
+}
+
+// Clears the pairing heap of all items.
+void pairingheap_clear(PairingHeap* h)
+{
+	PairingHeapNode* node = h->root;
+	PairingHeapNode* last;
+	PairingHeapNode* next;
+
+	// Splice the children of every node in after it so the whole tree
+	// becomes a single list of siblings that can be pooled in order.
+	while (node != NULL)
+	{
+		if (node->child != NULL)
+		{
+			last = node->child;
+			while (last->sibling != NULL)
+				last = last->sibling;
+
+			last->sibling = node->sibling;
+			node->sibling = node->child;
+		}
+
+		next = node->sibling;
+		push_PairingHeapNode(node);
+		node = next;
+	}
+
+	h->root = NULL;
+	h->size = 0;
+}
+
+// Clears the pairing heap of all items and frees the nodes and the heap
+// from memory.
+void pairingheap_free(PairingHeap* h)
+{
+	if (h == NULL)
+		return;
+
+	pairingheap_clear(h);
+	free(h);
+}
\ No newline at end of file
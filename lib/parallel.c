@@ -0,0 +1,207 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * Runs a loop over a range of indices on several threads. The range is cut
+ * into chunks and every thread, including the calling one, claims the next
+ * unclaimed chunk until none are left, so threads that finish early take
+ * on the work of slower ones. The operations that can be performed are:
+ *
+ * Threads => Returns the number of processors available.
+ * For => Calls a method on every chunk of a range of indices.
+ * Reduce => Combines the results of every chunk of a range of indices.
+ *
+ * @author Philip Diffenderfer
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "util.h"
+#include "parallel.h"
+#include "scheduler.h"
+
+/**
+ * The state shared by every thread running a parallel loop.
+ */
+typedef struct
+{
+	// The start index of the next chunk to claim.
+	atomic_ullong next;
+	// The number of indices to loop over.
+	unsigned int count;
+	// The number of indices in a chunk.
+	unsigned int chunk;
+	// The method called on every chunk of a parallel for.
+	void (*body)(unsigned int start, unsigned int end, void* arg);
+	// The method called on every chunk of a parallel reduce.
+	void* (*reduceBody)(unsigned int start, unsigned int end, void* arg);
+	// The method that combines two results of a parallel reduce.
+	void* (*combine)(void* a, void* b);
+	// The argument passed to every call of the body.
+	void* arg;
+	// The result of every chunk when reducing deterministically, else NULL.
+	void** results;
+	// The combined result of the chunks done so far when not deterministic.
+	void* result;
+	// Whether the result has been set yet.
+	int hasResult;
+	// The lock held while combining into the result.
+	pthread_mutex_t lock;
+
+} ParallelLoop;
+
+// Claims the next chunk of the loop, returning false if none are left.
+int parallel_claim(ParallelLoop* p, unsigned int* start, unsigned int* end)
+{
+	unsigned long long next = atomic_fetch_add(&p->next, p->chunk);
+
+	if (next >= p->count)
+		return false;
+
+	*start = (unsigned int)next;
+	*end = (unsigned int)min(next + p->chunk, p->count);
+
+	return true;
+}
+
+// Runs chunks of a parallel for until none are left.
+void parallel_forWorker(void* loop)
+{
+	ParallelLoop* p = (ParallelLoop*)loop;
+	unsigned int start, end;
+
+	while (parallel_claim(p, &start, &end))
+		p->body(start, end, p->arg);
+}
+
+// Runs chunks of a parallel reduce until none are left.
+void parallel_reduceWorker(void* loop)
+{
+	ParallelLoop* p = (ParallelLoop*)loop;
+	unsigned int start, end;
+	void* result;
+
+	while (parallel_claim(p, &start, &end))
+	{
+		result = p->reduceBody(start, end, p->arg);
+
+		if (p->results != NULL)
+		{
+			p->results[start / p->chunk] = result;
+			continue;
+		}
+
+		pthread_mutex_lock(&p->lock);
+
+		p->result = (p->hasResult ? p->combine(p->result, result) : result);
+		p->hasResult = true;
+
+		pthread_mutex_unlock(&p->lock);
+	}
+}
+
+// Runs the worker on the calling thread and as threads - 1 tasks on the
+// library's scheduler.
+void parallel_run(ParallelLoop* p, unsigned int threads, void (*worker)(void*))
+{
+	if (threads == 0)
+		threads = parallel_threads();
+
+	// No more threads are needed then there are chunks.
+	unsigned int chunks = (p->count - 1) / p->chunk + 1;
+	threads = min(threads, chunks);
+
+	Scheduler* s = scheduler_default();
+	TaskGroup group;
+	unsigned int i;
+
+	taskgroup_init(&group);
+
+	// Tasks that start after every chunk is claimed return right away.
+	for (i = 1; i < threads; i++)
+		scheduler_spawn(s, &group, worker, p);
+
+	worker(p);
+
+	scheduler_wait(s, &group);
+}
+
+// Returns the number of processors available to run threads on.
+unsigned int parallel_threads()
+{
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (count < 1 ? 1 : (unsigned int)count);
+}
+
+// Calls the body on every chunk of the indices using several threads.
+void parallel_for(unsigned int count, unsigned int chunk, unsigned int threads,
+	void (*body)(unsigned int start, unsigned int end, void* arg), void* arg)
+{
+	if (count == 0)
+		return;
+
+	ParallelLoop p;
+	atomic_init(&p.next, 0);
+	p.count = count;
+	p.chunk = (chunk == 0 ? PARALLEL_CHUNK : chunk);
+	p.body = body;
+	p.arg = arg;
+
+	parallel_run(&p, threads, &parallel_forWorker);
+}
+
+// Calls the body on every chunk of the indices using several threads and
+// combines the results.
+void* parallel_reduce(unsigned int count, unsigned int chunk, unsigned int threads,
+	void* (*body)(unsigned int start, unsigned int end, void* arg),
+	void* (*combine)(void* a, void* b), void* arg, int deterministic)
+{
+	if (count == 0)
+		return NULL;
+
+	ParallelLoop p;
+	atomic_init(&p.next, 0);
+	p.count = count;
+	p.chunk = (chunk == 0 ? PARALLEL_CHUNK : chunk);
+	p.reduceBody = body;
+	p.combine = combine;
+	p.arg = arg;
+	p.results = NULL;
+	p.result = NULL;
+	p.hasResult = false;
+
+	unsigned int chunks = (count - 1) / p.chunk + 1;
+	unsigned int i;
+
+	if (deterministic)
+		p.results = alloc(void*, chunks);
+	else
+		pthread_mutex_init(&p.lock, NULL);
+
+	parallel_run(&p, threads, &parallel_reduceWorker);
+
+	if (deterministic)
+	{
+		p.result = p.results[0];
+
+		for (i = 1; i < chunks; i++)
+			p.result = combine(p.result, p.results[i]);
+
+		free(p.results);
+	}
+	else
+	{
+		pthread_mutex_destroy(&p.lock);
+	}
+
+	return p.result;
+}
\ No newline at end of file
@@ -43,51 +43,51 @@ typedef struct
 
 
 // The pool to use for any Queue's nodes.
-Pool* pool;
+Pool* queuePool;
 
 // Creates a pool of QueueNodes.
 void pool_queue(unsigned int capacity)
 {
-	pool = alloc(Pool, 1);
+	queuePool = alloc(Pool, 1);
 
-	pool->capacity = capacity;
-	pool->size = 0;
-	pool->nodes = alloc(QueueNode*, capacity);
+	queuePool->capacity = capacity;
+	queuePool->size = 0;
+	queuePool->nodes = alloc(QueueNode*, capacity);
 }
 
 // Destroys the pool of QueueNodes.
 void unpool_queue()
 {
-	if (pool == NULL)
+	if (queuePool == NULL)
 		return;
 	
 	int i;
-	for (i = 0; i < pool->size; i++)
-		free(pool->nodes[i]);
+	for (i = 0; i < queuePool->size; i++)
+		free(queuePool->nodes[i]);
 
-	free(pool->nodes);
-	free(pool);
+	free(queuePool->nodes);
+	free(queuePool);
 
-	pool = NULL;
+	queuePool = NULL;
 }
 
 // Returns a node from the pool or allocates a new one.
 QueueNode* pop_QueueNode()
 {
-	if (pool == NULL)
+	if (queuePool == NULL)
 		return alloc(QueueNode, 1);
 
 	QueueNode* node;
 
-	if (pool->size == 0)
+	if (queuePool->size == 0)
 	{
 		node = alloc(QueueNode, 1);
 	}
 	else
 	{
-		pool->size--;
-		node = pool->nodes[pool->size];
-		pool->nodes[pool->size] = NULL;
+		queuePool->size--;
+		node = queuePool->nodes[queuePool->size];
+		queuePool->nodes[queuePool->size] = NULL;
 	}
 
 	return node;
@@ -100,18 +100,18 @@ void push_QueueNode(QueueNode* node)
 	if (node == NULL)
 		return;
 	// If the pooling isn't supported then just free the node from memory.
-	else if (pool == NULL)
+	else if (queuePool == NULL)
 	{
 		free(node);	
 		return;
 	}
 	// If the pool exists but is filled then exit.
-	else if (pool->size == pool->capacity)
+	else if (queuePool->size == queuePool->capacity)
 		return;
 
 	node->data = NULL;
 	node->next = NULL;
-	pool->nodes[pool->size++] = node;
+	queuePool->nodes[queuePool->size++] = node;
 }
 
 // Returns a queue with no size allocated to the heap.
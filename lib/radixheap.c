@@ -0,0 +1,178 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * This is a radix heap containing generic data which is ordered by some
+ * key value. A radix heap is a monotone priority queue: an item can only
+ * be added with a key greater then or equal to the key of the last item
+ * popped, which is the case for the distances in shortest path searches.
+ * In return every operation takes amortized constant time. The operations
+ * that can be performed on a radix heap are:
+ *
+ * Add => Add an item to the radix heap given a key.
+ * PeekMin => Returns the item that has the lowest key.
+ * PopMin => Removes and returns the item that has the lowest key.
+ * Clear => Clears all items from the heap.
+ * Free => Frees the heap from memory.
+ *
+ * @author Philip Diffenderfer
+ */
+
+#include "util.h"
+#include "radixheap.h"
+
+// The initial capacity of a bucket the first time an entry is put in it.
+#define RADIXHEAP_INITIAL	8
+
+// Returns the bucket a key belongs in, which is one more then the highest
+// bit the key differs from the last popped key, or 0 if they're equal.
+unsigned int radixheap_bucket(RadixHeap* h, unsigned int key)
+{
+	unsigned int diff = key ^ h->last;
+
+	if (diff == 0)
+		return 0;
+
+	return 32 - __builtin_clz(diff);
+}
+
+// Puts an entry at the end of a bucket, growing the bucket if it's full.
+void radixheap_put(RadixHeapBucket* b, unsigned int key, void* item)
+{
+	if (b->size == b->capacity)
+	{
+		b->capacity = (b->capacity == 0 ? RADIXHEAP_INITIAL : b->capacity << 1);
+		b->entries = realloc(b->entries, RadixHeapEntry, b->capacity);
+	}
+
+	b->entries[b->size].key = key;
+	b->entries[b->size].data = item;
+	b->size++;
+}
+
+// Returns the index of the lowest bucket which has entries.
+unsigned int radixheap_lowest(RadixHeap* h)
+{
+	unsigned int i = 0;
+	while (h->buckets[i].size == 0)
+		i++;
+
+	return i;
+}
+
+// Returns a new radix heap with no items.
+RadixHeap* newRadixHeap()
+{
+	RadixHeap* h = alloc(RadixHeap, 1);
+
+	h->size = 0;
+	h->last = 0;
+
+	unsigned int i;
+	for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+	{
+		h->buckets[i].size = 0;
+		h->buckets[i].capacity = 0;
+		h->buckets[i].entries = NULL;
+	}
+
+	return h;
+}
+
+// Adds to the radix heap.
+int radixheap_add(RadixHeap* h, unsigned int key, void* item)
+{
+	if (key < h->last)
+		return false;
+
+	radixheap_put(&h->buckets[radixheap_bucket(h, key)], key, item);
+	h->size++;
+
+	return true;
+}
+
+// Removes the item with the minimum key from the heap.
+void* radixheap_popMin(RadixHeap* h)
+{
+	if (h->size == 0)
+		return NULL;
+
+	// When nothing has the last key, move up to the lowest key in the
+	// lowest bucket and spread that bucket out into the buckets below it.
+	if (h->buckets[0].size == 0)
+	{
+		RadixHeapBucket* b = &h->buckets[radixheap_lowest(h)];
+		unsigned int i;
+		unsigned int lowest = b->entries[0].key;
+
+		for (i = 1; i < b->size; i++)
+			lowest = min(lowest, b->entries[i].key);
+
+		h->last = lowest;
+
+		for (i = 0; i < b->size; i++)
+			radixheap_put(&h->buckets[radixheap_bucket(h, b->entries[i].key)],
+				b->entries[i].key, b->entries[i].data);
+
+		b->size = 0;
+	}
+
+	RadixHeapBucket* zero = &h->buckets[0];
+
+	zero->size--;
+	h->size--;
+
+	return zero->entries[zero->size].data;
+}
+
+// Returns the item with the minimum key without removing it.
+void* radixheap_peekMin(RadixHeap* h)
+{
+	if (h->size == 0)
+		return NULL;
+
+	RadixHeapBucket* b = &h->buckets[radixheap_lowest(h)];
+	unsigned int i, best = 0;
+
+	for (i = 1; i < b->size; i++)
+		if (b->entries[i].key < b->entries[best].key)
+			best = i;
+
+	return b->entries[best].data;
+}
+
+// Returns true if the radix heap has no items in it.
+int radixheap_isEmpty(RadixHeap* h)
+{
+	return (h->size == 0);
+}
+
+// Clears the radix heap of all items.
+void radixheap_clear(RadixHeap* h)
+{
+	unsigned int i;
+	for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+		h->buckets[i].size = 0;
+
+	h->size = 0;
+	h->last = 0;
+}
+
+// Clears the radix heap of all items and frees it from memory.
+void radixheap_free(RadixHeap* h)
+{
+	if (h == NULL)
+		return;
+
+	unsigned int i;
+	for (i = 0; i < RADIXHEAP_BUCKETS; i++)
+		free(h->buckets[i].entries);
+
+	free(h);
+}
\ No newline at end of file
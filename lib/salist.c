@@ -0,0 +1,187 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+#include <string.h>
+
+#include "util.h"
+#include "salist.h"
+
+/**
+ * This is an array-list containing generic data that keeps its first few
+ * items inside the list itself. The operations that can be performed on a
+ * small array list are:
+ * 
+ * Init => Starts a list declared on the stack or in another structure.
+ * Add => Add an item to the end of the list.
+ * Insert => Insert an item into the list at some point.
+ * Remove => Remove an item from the list.
+ * RemoveAt => Remove an item at an index in the list.
+ * Reserve => Makes sure the list can hold some number of items.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Release => Frees any items spilled to the heap.
+ * Free => Frees the list from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+// Returns true if the items of the list have spilled to the heap.
+int salist_spilled(SmallArrayList* l)
+{
+	return (l->data != l->local);
+}
+
+// Moves the items of the list into an array on the heap of the given
+// capacity, or grows the array on the heap they're already in.
+void salist_spill(SmallArrayList* l, unsigned int capacity)
+{
+	if (salist_spilled(l))
+	{
+		l->data = realloc(l->data, void*, capacity);
+	}
+	else
+	{
+		l->data = alloc(void*, capacity);
+		memcpy(l->data, l->local, l->size * sizeof(void*));
+	}
+
+	l->capacity = capacity;
+}
+
+// Returns a new small array list with no items, allocated to the heap.
+SmallArrayList* newSmallArrayList()
+{
+	SmallArrayList* l = alloc(SmallArrayList, 1);
+
+	salist_init(l);
+
+	return l;
+}
+
+// Starts a small array list declared on the stack or in another structure.
+void salist_init(SmallArrayList* l)
+{
+	l->size = 0;
+	l->capacity = SALIST_INLINE;
+	l->data = l->local;
+}
+
+// Returns the i'th item in the small array list.
+void* salist_get(SmallArrayList* l, unsigned int index)
+{
+	if (index >= l->size)
+		return NULL;
+
+	return l->data[index];
+}
+
+// This will add an item to the end of the list.
+void salist_add(SmallArrayList* l, void* item)
+{
+	if (l->size == l->capacity)
+		salist_spill(l, l->capacity << 1);
+
+	l->data[l->size++] = item;
+}
+
+// Inserts data into a small array list at the given index.
+int salist_insert(SmallArrayList* l, void* item, unsigned int index)
+{
+	if (index > l->size)
+		return false;
+
+	if (l->size == l->capacity)
+		salist_spill(l, l->capacity << 1);
+
+	memmove(l->data + index + 1, l->data + index, (l->size - index) * sizeof(void*));
+
+	l->data[index] = item;
+	l->size++;
+
+	return true;
+}
+
+// Removes and returns the item at the given index.
+void* salist_removeAt(SmallArrayList* l, unsigned int index)
+{
+	if (index >= l->size)
+		return NULL;
+
+	void* item = l->data[index];
+
+	l->size--;
+	memmove(l->data + index, l->data + index + 1, (l->size - index) * sizeof(void*));
+
+	return item;
+}
+
+// Removes the first item from the list that equals the given item.
+void* salist_remove(SmallArrayList* l, void* item, int (*equals)(void*, void*))
+{
+	unsigned int i;
+	for (i = 0; i < l->size; i++)
+		if (equals(item, l->data[i]))
+			return salist_removeAt(l, i);
+
+	return NULL;
+}
+
+// Returns true if the small array list has no items in it.
+int salist_isEmpty(SmallArrayList* l)
+{
+	return (l->size == 0);
+}
+
+// Makes sure the list can hold at least the given number of items.
+void salist_reserve(SmallArrayList* l, unsigned int capacity)
+{
+	if (capacity > l->capacity)
+		salist_spill(l, capacity);
+}
+
+// Traverses the list from front to back.
+void salist_traverseForward(SmallArrayList* l, void (*process)(void* item))
+{
+	unsigned int i;
+	for (i = 0; i < l->size; i++)
+		process(l->data[i]);
+}
+
+// Traverses the list from back to front.
+void salist_traverseBackward(SmallArrayList* l, void (*process)(void* item))
+{
+	unsigned int i;
+	for (i = l->size; i > 0; i--)
+		process(l->data[i - 1]);
+}
+
+// Clears the list of all data, keeping any space on the heap.
+void salist_clear(SmallArrayList* l)
+{
+	l->size = 0;
+}
+
+// Clears the list and frees any items spilled to the heap.
+void salist_release(SmallArrayList* l)
+{
+	if (salist_spilled(l))
+		free(l->data);
+
+	salist_init(l);
+}
+
+// Removes the list completely from memory.
+void salist_free(SmallArrayList* l)
+{
+	if (l == NULL)
+		return;
+
+	salist_release(l);
+	free(l);
+}
\ No newline at end of file
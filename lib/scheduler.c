@@ -0,0 +1,404 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * A fork-join scheduler which runs tasks on a fixed pool of worker threads
+ * that steal work from each other. The operations that can be performed on
+ * a scheduler are:
+ * 
+ * Spawn => Adds a task to run later, optionally as part of a group.
+ * Wait => Runs tasks until every task in a group is done.
+ * ParallelFor => Calls a method on every chunk of a range of indices.
+ * Default => Returns a scheduler shared by the whole library.
+ * Free => Stops the workers and frees the scheduler from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+#include "util.h"
+#include "parallel.h"
+#include "scheduler.h"
+
+/**
+ * A task waiting to be run.
+ */
+typedef struct
+{
+	// The method of the task.
+	void (*run)(void* arg);
+	// The argument passed to the method.
+	void* arg;
+	// The group the task is part of, or NULL.
+	TaskGroup* group;
+
+} SchedulerTask;
+
+/**
+ * A range of indices of a parallel for which hasn't been run or split.
+ */
+typedef struct
+{
+	Scheduler* scheduler;
+	TaskGroup* group;
+	unsigned int start;
+	unsigned int end;
+	unsigned int chunk;
+	void (*body)(unsigned int start, unsigned int end, void* arg);
+	void* arg;
+
+} SchedulerRange;
+
+
+// The worker running on this thread, or NULL if it's not a worker.
+_Thread_local SchedulerWorker* schedulerWorker;
+
+// The scheduler shared by the library and the guard that starts it once.
+Scheduler* schedulerDefault;
+pthread_once_t schedulerOnce = PTHREAD_ONCE_INIT;
+
+
+// Returns the worker of the scheduler running on this thread, or NULL.
+SchedulerWorker* scheduler_current(Scheduler* s)
+{
+	SchedulerWorker* w = schedulerWorker;
+
+	return (w != NULL && w->scheduler == s ? w : NULL);
+}
+
+// Returns a random number from the worker's seed, used to pick victims.
+unsigned int scheduler_random(SchedulerWorker* w)
+{
+	unsigned int x = w->seed;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	return (w->seed = x);
+}
+
+// Wakes every sleeping thread after the epoch is bumped.
+void scheduler_wakeAll(Scheduler* s)
+{
+	atomic_fetch_add(&s->epoch, 1);
+
+	// Bumping the epoch and reading the sleepers are both sequentially
+	// consistent, so either a sleeper sees the new epoch or it's counted.
+	if (atomic_load(&s->sleepers) == 0)
+		return;
+
+	pthread_mutex_lock(&s->lock);
+	pthread_cond_broadcast(&s->wake);
+	pthread_mutex_unlock(&s->lock);
+}
+
+// Sleeps until the epoch changes from the one seen before looking for a task.
+void scheduler_sleep(Scheduler* s, unsigned int epoch)
+{
+	pthread_mutex_lock(&s->lock);
+	atomic_fetch_add(&s->sleepers, 1);
+
+	while (atomic_load(&s->epoch) == epoch)
+		pthread_cond_wait(&s->wake, &s->lock);
+
+	atomic_fetch_sub(&s->sleepers, 1);
+	pthread_mutex_unlock(&s->lock);
+}
+
+// Takes a task from the shared queue, or returns NULL if it's empty.
+SchedulerTask* scheduler_takeSubmitted(Scheduler* s)
+{
+	SchedulerTask* task = NULL;
+
+	if (atomic_load(&s->submittedCount) == 0)
+		return NULL;
+
+	pthread_mutex_lock(&s->submittedLock);
+
+	task = aqueue_poll(s->submitted);
+	if (task != NULL)
+		atomic_fetch_sub(&s->submittedCount, 1);
+
+	pthread_mutex_unlock(&s->submittedLock);
+
+	return task;
+}
+
+// Steals a task from any worker other than the given one, starting at a
+// random worker, or returns NULL if none had a task.
+SchedulerTask* scheduler_steal(Scheduler* s, SchedulerWorker* self)
+{
+	unsigned int start = (self != NULL ? scheduler_random(self) : 0);
+	unsigned int i;
+	SchedulerWorker* victim;
+	SchedulerTask* task;
+
+	for (i = 0; i < s->workerCount; i++)
+	{
+		victim = &s->workers[(start + i) % s->workerCount];
+
+		if (victim == self)
+			continue;
+
+		// A steal fails when another thread took the item first, so keep
+		// trying while the victim still has tasks.
+		while (!wsdeque_isEmpty(victim->deque))
+		{
+			task = wsdeque_steal(victim->deque);
+
+			if (task != NULL)
+				return task;
+		}
+	}
+
+	return NULL;
+}
+
+// Returns the next task the thread should run, or NULL if there are none.
+SchedulerTask* scheduler_find(Scheduler* s, SchedulerWorker* self)
+{
+	SchedulerTask* task = NULL;
+
+	if (self != NULL)
+		task = wsdeque_pop(self->deque);
+	if (task == NULL)
+		task = scheduler_takeSubmitted(s);
+	if (task == NULL)
+		task = scheduler_steal(s, self);
+
+	return task;
+}
+
+// Runs a task and finishes it in its group.
+void scheduler_execute(Scheduler* s, SchedulerTask* task)
+{
+	TaskGroup* group = task->group;
+
+	task->run(task->arg);
+	free(task);
+
+	// The last task in a group wakes any threads waiting on it.
+	if (group != NULL && atomic_fetch_sub(&group->pending, 1) == 1)
+		scheduler_wakeAll(s);
+}
+
+// The loop of a worker thread.
+void* scheduler_workerMain(void* worker)
+{
+	SchedulerWorker* w = (SchedulerWorker*)worker;
+	Scheduler* s = w->scheduler;
+	SchedulerTask* task;
+	unsigned int epoch;
+
+	schedulerWorker = w;
+
+	for (;;)
+	{
+		// Take the epoch before checking whether to stop, so a stop that
+		// comes after the check also changes the epoch and can't be slept
+		// through.
+		epoch = atomic_load(&s->epoch);
+
+		if (!atomic_load(&s->running))
+			break;
+
+		task = scheduler_find(s, w);
+
+		if (task != NULL)
+			scheduler_execute(s, task);
+		else
+			scheduler_sleep(s, epoch);
+	}
+
+	return NULL;
+}
+
+// Runs a range of a parallel for, spawning halves of it until it's small.
+void scheduler_runRange(void* range)
+{
+	SchedulerRange* r = (SchedulerRange*)range;
+	SchedulerRange* right;
+	unsigned int middle;
+
+	while (r->end - r->start > r->chunk)
+	{
+		middle = r->start + (r->end - r->start) / 2;
+
+		right = alloc(SchedulerRange, 1);
+		*right = *r;
+		right->start = middle;
+		r->end = middle;
+
+		scheduler_spawn(r->scheduler, r->group, &scheduler_runRange, right);
+	}
+
+	r->body(r->start, r->end, r->arg);
+	free(r);
+}
+
+// Starts the scheduler shared by the library.
+void scheduler_startDefault()
+{
+	schedulerDefault = newScheduler(0);
+}
+
+// Returns a scheduler with its workers started.
+Scheduler* newScheduler(unsigned int threads)
+{
+	Scheduler* s = alloc(Scheduler, 1);
+	unsigned int i;
+
+	if (threads == 0)
+		threads = parallel_threads();
+
+	s->workerCount = threads;
+	s->workers = alloc(SchedulerWorker, threads);
+	s->submitted = newArrayQueue(16);
+	atomic_init(&s->submittedCount, 0);
+	pthread_mutex_init(&s->submittedLock, NULL);
+	atomic_init(&s->epoch, 0);
+	atomic_init(&s->sleepers, 0);
+	pthread_mutex_init(&s->lock, NULL);
+	pthread_cond_init(&s->wake, NULL);
+	atomic_init(&s->running, true);
+
+	// Every deque exists before any worker starts stealing from them.
+	for (i = 0; i < threads; i++)
+	{
+		s->workers[i].deque = newWorkStealingDeque(64);
+		s->workers[i].scheduler = s;
+		s->workers[i].seed = i * 2654435761u + 1;
+	}
+
+	for (i = 0; i < threads; i++)
+		pthread_create(&s->workers[i].thread, NULL, &scheduler_workerMain, &s->workers[i]);
+
+	return s;
+}
+
+// Returns the scheduler shared by the library's parallel operations.
+Scheduler* scheduler_default()
+{
+	pthread_once(&schedulerOnce, &scheduler_startDefault);
+
+	return schedulerDefault;
+}
+
+// Initializes a group with no tasks.
+void taskgroup_init(TaskGroup* g)
+{
+	atomic_init(&g->pending, 0);
+}
+
+// Adds a task to the scheduler to be run on some worker.
+void scheduler_spawn(Scheduler* s, TaskGroup* g, void (*run)(void* arg), void* arg)
+{
+	SchedulerTask* task = alloc(SchedulerTask, 1);
+	SchedulerWorker* self = scheduler_current(s);
+
+	task->run = run;
+	task->arg = arg;
+	task->group = g;
+
+	if (g != NULL)
+		atomic_fetch_add(&g->pending, 1);
+
+	if (self != NULL)
+	{
+		wsdeque_push(self->deque, task);
+	}
+	else
+	{
+		pthread_mutex_lock(&s->submittedLock);
+		aqueue_offerf(s->submitted, task);
+		atomic_fetch_add(&s->submittedCount, 1);
+		pthread_mutex_unlock(&s->submittedLock);
+	}
+
+	scheduler_wakeAll(s);
+}
+
+// Runs tasks until every task in the group is done.
+void scheduler_wait(Scheduler* s, TaskGroup* g)
+{
+	SchedulerWorker* self = scheduler_current(s);
+	SchedulerTask* task;
+	unsigned int epoch;
+
+	while (atomic_load(&g->pending) > 0)
+	{
+		epoch = atomic_load(&s->epoch);
+		task = scheduler_find(s, self);
+
+		if (task != NULL)
+			scheduler_execute(s, task);
+		else if (atomic_load(&g->pending) > 0)
+			scheduler_sleep(s, epoch);
+	}
+}
+
+// Calls the body on every chunk of the indices on the scheduler's workers.
+void scheduler_parallelFor(Scheduler* s, unsigned int count, unsigned int chunk,
+	void (*body)(unsigned int start, unsigned int end, void* arg), void* arg)
+{
+	if (count == 0)
+		return;
+
+	TaskGroup group;
+	taskgroup_init(&group);
+
+	SchedulerRange* range = alloc(SchedulerRange, 1);
+	range->scheduler = s;
+	range->group = &group;
+	range->start = 0;
+	range->end = count;
+	range->chunk = (chunk == 0 ? SCHEDULER_CHUNK : chunk);
+	range->body = body;
+	range->arg = arg;
+
+	// The calling thread starts splitting the range itself.
+	scheduler_runRange(range);
+	scheduler_wait(s, &group);
+}
+
+// Stops the workers and frees the scheduler from memory.
+void scheduler_free(Scheduler* s)
+{
+	if (s == NULL)
+		return;
+
+	unsigned int i;
+	SchedulerTask* task;
+
+	atomic_store(&s->running, false);
+	scheduler_wakeAll(s);
+
+	for (i = 0; i < s->workerCount; i++)
+		pthread_join(s->workers[i].thread, NULL);
+
+	// Discard the tasks that never ran.
+	for (i = 0; i < s->workerCount; i++)
+	{
+		while ((task = wsdeque_pop(s->workers[i].deque)) != NULL)
+			free(task);
+
+		wsdeque_free(s->workers[i].deque);
+	}
+
+	while ((task = aqueue_poll(s->submitted)) != NULL)
+		free(task);
+
+	aqueue_free(s->submitted);
+	pthread_cond_destroy(&s->wake);
+	pthread_mutex_destroy(&s->lock);
+	pthread_mutex_destroy(&s->submittedLock);
+
+	free(s->workers);
+	free(s);
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * An array based queue containing generic data which one thread offers to
+ * and another thread polls from at the same time without locks. The
+ * operations that can be performed on an spsc queue are:
+ * 
+ * Offer => Adds an item to the end of the queue (producer only).
+ * OfferMany => Adds an array of items to the end of the queue (producer only).
+ * Poll => Removes and returns the item at the front of the queue (consumer only).
+ * PollMany => Removes items from the front of the queue into an array (consumer only).
+ * Peek => Returns the item at the front of the queue (consumer only).
+ * Size => Returns the number of items in the queue.
+ * Free => Frees the queue from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+#include <string.h>
+
+#include "util.h"
+#include "spscqueue.h"
+
+// Returns the number of free slots the producer knows of, reading the
+// head again only if the cached one doesn't show enough free slots.
+unsigned int spsc_freeSlots(SpscQueue* q, unsigned int tail, unsigned int wanted)
+{
+	unsigned int available = q->capacity - (tail - q->headCache);
+
+	if (available < wanted)
+	{
+		q->headCache = atomic_load_explicit(&q->head, memory_order_acquire);
+		available = q->capacity - (tail - q->headCache);
+	}
+
+	return available;
+}
+
+// Returns the number of items the consumer knows of, reading the tail
+// again only if the cached one doesn't show enough items.
+unsigned int spsc_usedSlots(SpscQueue* q, unsigned int head, unsigned int wanted)
+{
+	unsigned int used = q->tailCache - head;
+
+	if (used < wanted)
+	{
+		q->tailCache = atomic_load_explicit(&q->tail, memory_order_acquire);
+		used = q->tailCache - head;
+	}
+
+	return used;
+}
+
+// Returns an empty spsc queue allocated to the heap.
+SpscQueue* newSpscQueue(unsigned int capacity)
+{
+	SpscQueue* q;
+
+	if (posix_memalign((void**)&q, CACHE_LINE, sizeof(SpscQueue)) != 0)
+		return NULL;
+
+	// Determine the next size thats a power of 2
+	unsigned int actual = 1;
+	while (actual < capacity)
+		actual <<= 1;
+
+	atomic_init(&q->head, 0);
+	atomic_init(&q->tail, 0);
+	q->tailCache = 0;
+	q->headCache = 0;
+	q->capacity = actual;
+	q->mask = actual - 1;
+	q->data = alloc(void*, actual);
+
+	return q;
+}
+
+// Adds an item to the end of the queue.
+int spsc_offer(SpscQueue* q, void* item)
+{
+	unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+	if (spsc_freeSlots(q, tail, 1) == 0)
+		return false;
+
+	q->data[tail & q->mask] = item;
+
+	// Publish the item, the consumer's acquire load of the tail sees it.
+	atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+
+	return true;
+}
+
+// Adds as many items from the array as fit to the end of the queue.
+unsigned int spsc_offerMany(SpscQueue* q, void** items, unsigned int count)
+{
+	unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+	unsigned int n = min(count, spsc_freeSlots(q, tail, count));
+
+	if (n == 0)
+		return 0;
+
+	// Copy up to the end of the array and then wrap around to the start.
+	unsigned int index = tail & q->mask;
+	unsigned int first = min(n, q->capacity - index);
+
+	memcpy(q->data + index, items, first * sizeof(void*));
+	memcpy(q->data, items + first, (n - first) * sizeof(void*));
+
+	atomic_store_explicit(&q->tail, tail + n, memory_order_release);
+
+	return n;
+}
+
+// Removes and returns the item at the front of the queue.
+void* spsc_poll(SpscQueue* q)
+{
+	unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+	if (spsc_usedSlots(q, head, 1) == 0)
+		return NULL;
+
+	void* item = q->data[head & q->mask];
+
+	// Hand the slot back, the producer's acquire load of the head sees it.
+	atomic_store_explicit(&q->head, head + 1, memory_order_release);
+
+	return item;
+}
+
+// Removes up to max items from the front of the queue into the buffer.
+unsigned int spsc_pollMany(SpscQueue* q, void** buffer, unsigned int max)
+{
+	unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+	unsigned int n = min(max, spsc_usedSlots(q, head, max));
+
+	if (n == 0)
+		return 0;
+
+	unsigned int index = head & q->mask;
+	unsigned int first = min(n, q->capacity - index);
+
+	memcpy(buffer, q->data + index, first * sizeof(void*));
+	memcpy(buffer + first, q->data, (n - first) * sizeof(void*));
+
+	atomic_store_explicit(&q->head, head + n, memory_order_release);
+
+	return n;
+}
+
+// Returns the item at the front of the queue without removing it.
+void* spsc_peek(SpscQueue* q)
+{
+	unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+	if (spsc_usedSlots(q, head, 1) == 0)
+		return NULL;
+
+	return q->data[head & q->mask];
+}
+
+// Returns the number of items in the queue.
+unsigned int spsc_size(SpscQueue* q)
+{
+	unsigned int head = atomic_load_explicit(&q->head, memory_order_acquire);
+	unsigned int tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+
+	return tail - head;
+}
+
+// Returns true if the queue has no items.
+int spsc_isEmpty(SpscQueue* q)
+{
+	return (spsc_size(q) == 0);
+}
+
+// Removes the queue completely from memory.
+void spsc_free(SpscQueue* q)
+{
+	if (q == NULL)
+		return;
+
+	free(q->data);
+	free(q);
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * A stack containing generic data stored in fixed size chunks linked
+ * together. The operations that can be performed on a segmented stack are:
+ * 
+ * Pop => Removes and returns the item at the top of the stack.
+ * Peek => Returns the item at the top of the stack.
+ * Push => Adds an item to the top of the stack.
+ * Traverse => Traverses the stack of items from the top down.
+ * Clear => Clears all items from the stack.
+ * Free => Frees the stack from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+#include "util.h"
+#include "sstack.h"
+
+// Returns an empty segmented stack allocated to the heap.
+SegmentedStack* newSegmentedStack()
+{
+	SegmentedStack* s = alloc(SegmentedStack, 1);
+
+	s->size = 0;
+	s->count = 0;
+	s->top = NULL;
+	s->spare = NULL;
+
+	return s;
+}
+
+// Returns and removes the top item on the stack.
+void* sstack_pop(SegmentedStack* s)
+{
+	if (s->size == 0)
+		return NULL;
+
+	void* item = s->top->items[--s->count];
+	s->size--;
+
+	// Move down to the chunk below once this one is empty, keeping this
+	// one as the spare in place of any older spare.
+	if (s->count == 0 && s->top->below != NULL)
+	{
+		SegmentedStackChunk* empty = s->top;
+
+		s->top = empty->below;
+		s->count = SSTACK_CHUNK;
+
+		free(s->spare);
+		s->spare = empty;
+	}
+
+	return item;
+}
+
+// Returns the top item on the stack.
+void* sstack_peek(SegmentedStack* s)
+{
+	if (s->size == 0)
+		return NULL;
+
+	return s->top->items[s->count - 1];
+}
+
+// Adds an item to the top of the stack.
+void sstack_push(SegmentedStack* s, void* item)
+{
+	// Start a new chunk when the top one is full or there isn't one.
+	if (s->top == NULL || s->count == SSTACK_CHUNK)
+	{
+		SegmentedStackChunk* chunk = s->spare;
+
+		if (chunk == NULL)
+			chunk = alloc(SegmentedStackChunk, 1);
+		else
+			s->spare = NULL;
+
+		chunk->below = s->top;
+		s->top = chunk;
+		s->count = 0;
+	}
+
+	s->top->items[s->count++] = item;
+	s->size++;
+}
+
+// Returns true if the stack has no items.
+int sstack_isEmpty(SegmentedStack* s)
+{
+	return (s->size == 0);
+}
+
+// Traverse the stack without affecting it starting at the top of the
+// stack and moving towards the bottom. Each item traversed will be sent
+// through the process method.
+void sstack_traverseDown(SegmentedStack* s, void (*process)(void* item))
+{
+	if (s->size == 0)
+		return;
+
+	SegmentedStackChunk* chunk = s->top;
+	unsigned int count = s->count;
+
+	while (chunk != NULL)
+	{
+		while (count > 0)
+			process(chunk->items[--count]);
+
+		chunk = chunk->below;
+		count = SSTACK_CHUNK;
+	}
+}
+
+// Clears the stack of all items.
+void sstack_clear(SegmentedStack* s)
+{
+	SegmentedStackChunk* chunk = s->top;
+	SegmentedStackChunk* below;
+
+	// Keep one chunk as the spare so refilling the stack doesn't allocate.
+	if (s->spare == NULL && chunk != NULL)
+	{
+		s->spare = chunk;
+		chunk = chunk->below;
+	}
+
+	while (chunk != NULL)
+	{
+		below = chunk->below;
+		free(chunk);
+		chunk = below;
+	}
+
+	s->size = 0;
+	s->count = 0;
+	s->top = NULL;
+}
+
+// Removes the stack and all of its chunks completely from memory.
+void sstack_free(SegmentedStack* s)
+{
+	if (s == NULL)
+		return;
+
+	sstack_clear(s);
+	free(s->spare);
+	free(s);
+}
\ No newline at end of file
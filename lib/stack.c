@@ -43,55 +43,55 @@ typedef struct
 
 
 // The pool to use for any Queue's nodes.
-Pool* pool;
+Pool* stackPool;
 
 
 // Creates a pool of StackNodes.
 void pool_stack(unsigned int capacity)
 {
-	pool = alloc(Pool, 1);
+	stackPool = alloc(Pool, 1);
 
-	pool->capacity = capacity;
-	pool->size = 0;
-	pool->nodes = alloc(StackNode*, capacity);
+	stackPool->capacity = capacity;
+	stackPool->size = 0;
+	stackPool->nodes = alloc(StackNode*, capacity);
 }
 
 // Destroys the pool of StackNodes.
 void unpool_stack()
 {
-	if (pool == NULL)
+	if (stackPool == NULL)
 		return;
 	
 	unsigned int i;
-	for (i = 0; i < pool->size; i++)
-		free(pool->nodes[i]);
+	for (i = 0; i < stackPool->size; i++)
+		free(stackPool->nodes[i]);
 
-	free(pool->nodes);
-	free(pool);
+	free(stackPool->nodes);
+	free(stackPool);
 
-	pool = NULL;
+	stackPool = NULL;
 }
 
 // Returns a node from the pool or allocates a new one.
 StackNode* pop_StackNode()
 {
 	// Of pooling isn't supported then just allocate a new one.
-	if (pool == NULL)
+	if (stackPool == NULL)
 		return alloc(StackNode, 1);
 
 	StackNode* node;
 
 	// If there are none on the pool then allocate a new one
-	if (pool->size == 0)
+	if (stackPool->size == 0)
 	{
 		node = alloc(StackNode, 1);
 	}
 	// If there is one on the pool grab one from the back.
 	else
 	{
-		pool->size--;
-		node = pool->nodes[pool->size];
-		pool->nodes[pool->size] = NULL;
+		stackPool->size--;
+		node = stackPool->nodes[stackPool->size];
+		stackPool->nodes[stackPool->size] = NULL;
 	}
 
 	return node;
@@ -104,19 +104,19 @@ void push_StackNode(StackNode* node)
 	if (node == NULL)
 		return;
 	// If the pooling isn't supported then just free the node from memory.
-	else if (pool == NULL)
+	else if (stackPool == NULL)
 	{
 		free(node);	
 		return;
 	}
 	// If the pool exists but is filled then exit.
-	else if (pool->size == pool->capacity)
+	else if (stackPool->size == stackPool->capacity)
 		return;
 
 	// push the node into the pool.
 	node->data = NULL;
 	node->previous = NULL;
-	pool->nodes[pool->size++] = node;
+	stackPool->nodes[stackPool->size++] = node;
 }
 
 
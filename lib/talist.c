@@ -0,0 +1,22 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * The typed array lists defined by the library. A typed array-list stores
+ * its items by value in one contiguous array instead of storing pointers
+ * to items. See talist.h for defining a typed array list of another type.
+ *
+ * @author Philip Diffenderfer
+ */
+
+#include "talist.h"
+
+ALIST_DEFINE(int)
+ALIST_DEFINE(float)
+ALIST_DEFINE(double)
\ No newline at end of file
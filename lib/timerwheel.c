@@ -0,0 +1,364 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * A hierarchical timing wheel containing generic data which expires at some
+ * tick in the future. Each level holds timers which expire further in the
+ * future then the level below it, and as time advances the timers cascade
+ * down into the lower levels until they expire. The operations that can be
+ * performed on a timer wheel are:
+ *
+ * Schedule => Schedules an item to expire some number of ticks from now.
+ * Cancel => Cancels a scheduled timer before it expires.
+ * Advance => Moves time forward expiring any timers along the way.
+ * Clear => Clears all timers from the wheel.
+ * Free => Frees the wheel from memory.
+ *
+ * @author Philip Diffenderfer
+ */
+
+#include "util.h"
+#include "timerwheel.h"
+
+// The mask of a tick to get the slot on a level.
+#define TIMERWHEEL_MASK		(TIMERWHEEL_SLOTS - 1)
+
+/**
+ * A pool is a stack like structure that can pop and push TimerNodes.
+ * If there are no TimerNodes to pop and a request is made then the
+ * pool will allocate a TimerNode on the spot. A pool is restricted
+ * by a maximum capcity.
+ */
+typedef struct
+{
+	// The current number of nodes available for unpooling.
+	unsigned int size;
+	// The maximum number of nodes that can be pooled.
+	unsigned int capacity;
+	// The array of node pointers for pooling/unpooling.
+	TimerNode** nodes;
+
+} Pool;
+
+
+// The pool to use for any TimerWheel's nodes.
+Pool* timerPool;
+
+
+// Creates a pool of TimerNodes.
+void pool_timerwheel(unsigned int capacity)
+{
+	timerPool = alloc(Pool, 1);
+
+	timerPool->capacity = capacity;
+	timerPool->size = 0;
+	timerPool->nodes = alloc(TimerNode*, capacity);
+}
+
+// Destroys the pool of TimerNodes.
+void unpool_timerwheel()
+{
+	if (timerPool == NULL)
+		return;
+
+	unsigned int i;
+	for (i = 0; i < timerPool->size; i++)
+		free(timerPool->nodes[i]);
+
+	free(timerPool->nodes);
+	free(timerPool);
+
+	timerPool = NULL;
+}
+
+// Returns a node from the pool or allocates a new one.
+TimerNode* pop_TimerNode()
+{
+	// If pooling isn't supported then just allocate a new one.
+	if (timerPool == NULL)
+		return alloc(TimerNode, 1);
+
+	TimerNode* node;
+
+	// If there are none on the pool then allocate a new one
+	if (timerPool->size == 0)
+	{
+		node = alloc(TimerNode, 1);
+	}
+	// If there is one on the pool grab one from the back.
+	else
+	{
+		timerPool->size--;
+		node = timerPool->nodes[timerPool->size];
+		timerPool->nodes[timerPool->size] = NULL;
+	}
+
+	return node;
+}
+
+// Puts the node on the pool if there is space.
+void push_TimerNode(TimerNode* node)
+{
+	// If the node passed in is null just exit
+	if (node == NULL)
+		return;
+	// If the pooling isn't supported then just free the node from memory.
+	else if (timerPool == NULL)
+	{
+		free(node);
+		return;
+	}
+	// If the pool exists but is filled then free the node.
+	else if (timerPool->size == timerPool->capacity)
+	{
+		free(node);
+		return;
+	}
+
+	// push the node into the pool.
+	node->data = NULL;
+	node->previous = NULL;
+	node->next = NULL;
+	timerPool->nodes[timerPool->size++] = node;
+}
+
+// Makes the given slot an empty circular list.
+void timerwheel_emptySlot(TimerNode* slot)
+{
+	slot->data = NULL;
+	slot->previous = slot;
+	slot->next = slot;
+}
+
+// Links a node onto the end of the given slot.
+void timerwheel_link(TimerNode* slot, TimerNode* node)
+{
+	node->next = slot;
+	node->previous = slot->previous;
+	slot->previous->next = node;
+	slot->previous = node;
+}
+
+// Unlinks a node from whichever slot it's in.
+void timerwheel_unlink(TimerNode* node)
+{
+	node->previous->next = node->next;
+	node->next->previous = node->previous;
+	node->previous = NULL;
+	node->next = NULL;
+}
+
+// Moves every node in the slot 'from' to the empty slot 'to'.
+void timerwheel_moveSlot(TimerNode* from, TimerNode* to)
+{
+	if (from->next == from)
+	{
+		timerwheel_emptySlot(to);
+		return;
+	}
+
+	to->next = from->next;
+	to->previous = from->previous;
+	to->next->previous = to;
+	to->previous->next = to;
+
+	timerwheel_emptySlot(from);
+}
+
+// Places a node in the slot on the lowest level that can hold its expiry.
+void timerwheel_place(TimerWheel* w, TimerNode* node)
+{
+	unsigned int delta = node->expires - w->now;
+	unsigned int level = 0;
+
+	while (level < TIMERWHEEL_LEVELS - 1 &&
+			 (delta >> (TIMERWHEEL_BITS * (level + 1))) != 0)
+		level++;
+
+	unsigned int slot = (node->expires >> (TIMERWHEEL_BITS * level)) & TIMERWHEEL_MASK;
+
+	timerwheel_link(&w->slots[level][slot], node);
+}
+
+// Moves all the timers in a slot of a higher level down to the lower levels.
+void timerwheel_cascade(TimerWheel* w, unsigned int level, unsigned int slot)
+{
+	TimerNode pending;
+	TimerNode* node;
+
+	timerwheel_moveSlot(&w->slots[level][slot], &pending);
+
+	while (pending.next != &pending)
+	{
+		node = pending.next;
+		timerwheel_unlink(node);
+		timerwheel_place(w, node);
+	}
+}
+
+// Moves the wheel forward a single tick expiring any timers on that tick.
+unsigned int timerwheel_tick(TimerWheel* w, void (*expire)(void* item))
+{
+	w->now++;
+
+	unsigned int index = w->now & TIMERWHEEL_MASK;
+	unsigned int level, slot;
+
+	// When the lowest level wraps around pull down the timers from the
+	// next level, and so on for as long as each level wraps as well.
+	if (index == 0)
+	{
+		for (level = 1; level < TIMERWHEEL_LEVELS; level++)
+		{
+			slot = (w->now >> (TIMERWHEEL_BITS * level)) & TIMERWHEEL_MASK;
+			timerwheel_cascade(w, level, slot);
+
+			if (slot != 0)
+				break;
+		}
+	}
+
+	// Detach the slot first so the expire method can schedule or cancel
+	// timers without disturbing the ones being expired.
+	TimerNode expired;
+	TimerNode* node;
+	void* data;
+	unsigned int count = 0;
+
+	timerwheel_moveSlot(&w->slots[0][index], &expired);
+
+	while (expired.next != &expired)
+	{
+		node = expired.next;
+		data = node->data;
+
+		timerwheel_unlink(node);
+		push_TimerNode(node);
+		w->size--;
+		count++;
+
+		if (expire != NULL)
+			expire(data);
+	}
+
+	return count;
+}
+
+// Returns a new timer wheel with no timers starting at tick 0.
+TimerWheel* newTimerWheel()
+{
+	TimerWheel* w = alloc(TimerWheel, 1);
+
+	w->size = 0;
+	w->now = 0;
+
+	unsigned int level, slot;
+	for (level = 0; level < TIMERWHEEL_LEVELS; level++)
+		for (slot = 0; slot < TIMERWHEEL_SLOTS; slot++)
+			timerwheel_emptySlot(&w->slots[level][slot]);
+
+	return w;
+}
+
+// Schedules an item to expire after the given number of ticks.
+TimerNode* timerwheel_schedule(TimerWheel* w, unsigned int delay, void* item)
+{
+	// A timer can't expire on the tick that has already passed.
+	if (delay == 0)
+		delay = 1;
+
+	TimerNode* node = pop_TimerNode();
+	node->data = item;
+	node->expires = w->now + delay;
+
+	timerwheel_place(w, node);
+	w->size++;
+
+	return node;
+}
+
+// Cancels a timer that has not yet expired and returns its item.
+void* timerwheel_cancel(TimerWheel* w, TimerNode* timer)
+{
+	if (timer == NULL)
+		return NULL;
+
+	void* data = timer->data;
+
+	timerwheel_unlink(timer);
+	push_TimerNode(timer);
+	w->size--;
+
+	return data;
+}
+
+// Moves the wheel forward some number of ticks expiring timers on the way.
+unsigned int timerwheel_advance(TimerWheel* w, unsigned int ticks, void (*expire)(void* item))
+{
+	unsigned int count = 0;
+
+	while (ticks > 0)
+	{
+		// With nothing scheduled the remaining ticks can be skipped.
+		if (w->size == 0)
+		{
+			w->now += ticks;
+			break;
+		}
+
+		count += timerwheel_tick(w, expire);
+		ticks--;
+	}
+
+	return count;
+}
+
+// Returns true if the timer wheel has no timers scheduled.
+int timerwheel_isEmpty(TimerWheel* w)
+{
+	return (w->size == 0);
+}
+
+// Clears the timer wheel of all timers without expiring them.
+void timerwheel_clear(TimerWheel* w)
+{
+	if (w->size == 0)
+		return;
+
+	unsigned int level, slot;
+	TimerNode* head;
+	TimerNode* node;
+
+	for (level = 0; level < TIMERWHEEL_LEVELS; level++)
+	{
+		for (slot = 0; slot < TIMERWHEEL_SLOTS; slot++)
+		{
+			head = &w->slots[level][slot];
+
+			while (head->next != head)
+			{
+				node = head->next;
+				timerwheel_unlink(node);
+				push_TimerNode(node);
+			}
+		}
+	}
+
+	w->size = 0;
+}
+
+// Clears the timer wheel of all timers and frees the wheel from memory.
+void timerwheel_free(TimerWheel* w)
+{
+	if (w == NULL)
+		return;
+
+	timerwheel_clear(w);
+	free(w);
+}
\ No newline at end of file
@@ -0,0 +1,416 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * This is an unrolled linked-list containing generic data. The operations
+ * that can be performed on an unrolled list are:
+ * 
+ * Get => Gets an item at an index.
+ * Add => Add an item to the end of the list.
+ * AddFirst => Adds an item to the beginning of the list.
+ * RemoveFirst => Removes and Returns the first item in the list.
+ * Start => Starts the traversing of the list at the beginning.
+ * Peek => Returns the current item being traversed.
+ * Next => Goes to the next item to traverse.
+ * Remove => Removes the current item being traversed from the list.
+ * InsertAfter => Inserts an item after the current item being traversed.
+ * InsertBefore => Inserts an item before the current item being traversed.
+ * HasNext => Returns true when there's another item to traverse.
+ * Traverse => Traverses the list of items.
+ * Clear => Clears all items from the list.
+ * Free => Frees the list from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+#include <string.h>
+
+#include "util.h"
+#include "ulist.h"
+
+/**
+ * A pool is a stack like structure that can pop and push UnrolledListNodes.
+ * If there are no UnrolledListNodes to pop and a request is made then the
+ * pool will allocate an UnrolledListNode on the spot. A pool is restricted
+ * by a maximum capcity.
+ */
+typedef struct
+{
+	// The current number of nodes available for unpooling.
+	unsigned int size;
+	// The maximum number of nodes that can be pooled.
+	unsigned int capacity;
+	// The array of node pointers for pooling/unpooling.
+	UnrolledListNode** nodes;
+
+} Pool;
+
+
+// The pool to use for any UnrolledList's nodes.
+Pool* ulistPool;
+
+
+// Creates a pool of UnrolledListNodes.
+void pool_ulist(unsigned int capacity)
+{
+	ulistPool = alloc(Pool, 1);
+
+	ulistPool->capacity = capacity;
+	ulistPool->size = 0;
+	ulistPool->nodes = alloc(UnrolledListNode*, capacity);
+}
+
+// Destroys the pool of UnrolledListNodes.
+void unpool_ulist()
+{
+	if (ulistPool == NULL)
+		return;
+
+	unsigned int i;
+	for (i = 0; i < ulistPool->size; i++)
+		free(ulistPool->nodes[i]);
+
+	free(ulistPool->nodes);
+	free(ulistPool);
+
+	ulistPool = NULL;
+}
+
+// Returns a node from the pool or allocates a new one.
+UnrolledListNode* pop_UnrolledListNode()
+{
+	if (ulistPool == NULL || ulistPool->size == 0)
+		return alloc(UnrolledListNode, 1);
+
+	ulistPool->size--;
+	UnrolledListNode* node = ulistPool->nodes[ulistPool->size];
+	ulistPool->nodes[ulistPool->size] = NULL;
+
+	return node;
+}
+
+// Puts the node on the pool if there is space, otherwise frees it.
+void push_UnrolledListNode(UnrolledListNode* node)
+{
+	if (node == NULL)
+		return;
+
+	if (ulistPool == NULL || ulistPool->size == ulistPool->capacity)
+	{
+		free(node);
+		return;
+	}
+
+	node->previous = NULL;
+	node->next = NULL;
+	ulistPool->nodes[ulistPool->size++] = node;
+}
+
+// Links a new empty node into the list after the given node, or at the
+// front of the list if the given node is NULL.
+UnrolledListNode* ulist_newNode(UnrolledList* l, UnrolledListNode* before)
+{
+	UnrolledListNode* node = pop_UnrolledListNode();
+	UnrolledListNode* after = (before == NULL ? l->first : before->next);
+
+	node->count = 0;
+	node->previous = before;
+	node->next = after;
+
+	if (before != NULL)
+		before->next = node;
+	else
+		l->first = node;
+
+	if (after != NULL)
+		after->previous = node;
+	else
+		l->last = node;
+
+	return node;
+}
+
+// Unlinks a node from the list and puts it back on the pool.
+void ulist_unlink(UnrolledList* l, UnrolledListNode* node)
+{
+	if (node->previous != NULL)
+		node->previous->next = node->next;
+	else
+		l->first = node->next;
+
+	if (node->next != NULL)
+		node->next->previous = node->previous;
+	else
+		l->last = node->previous;
+
+	push_UnrolledListNode(node);
+}
+
+// Inserts an item at an index of a node, splitting the node in half if
+// it's full. The cursor is kept on the same item it was on.
+void ulist_insertAt(UnrolledList* l, UnrolledListNode* node, unsigned int index, void* item)
+{
+	if (node->count == ULIST_ITEMS)
+	{
+		unsigned int half = ULIST_ITEMS >> 1;
+		UnrolledListNode* right = ulist_newNode(l, node);
+
+		memcpy(right->items, node->items + half, half * sizeof(void*));
+		right->count = half;
+		node->count = half;
+
+		if (l->current == node && l->index >= half)
+		{
+			l->current = right;
+			l->index -= half;
+		}
+
+		if (index > half)
+		{
+			node = right;
+			index -= half;
+		}
+	}
+
+	memmove(node->items + index + 1, node->items + index, (node->count - index) * sizeof(void*));
+	node->items[index] = item;
+	node->count++;
+	l->size++;
+
+	if (l->current == node && l->index >= index)
+		l->index++;
+}
+
+// Removes and returns the item at an index of a node. An empty node is
+// unlinked, and a node less then half full takes the items of the next
+// node if they fit. A cursor on the removed item moves to the next item,
+// otherwise it's kept on the same item it was on.
+void* ulist_removeAt(UnrolledList* l, UnrolledListNode* node, unsigned int index)
+{
+	void* item = node->items[index];
+	UnrolledListNode* next = node->next;
+
+	node->count--;
+	memmove(node->items + index, node->items + index + 1, (node->count - index) * sizeof(void*));
+	l->size--;
+
+	if (l->current == node && l->index > index)
+		l->index--;
+
+	if (node->count == 0)
+	{
+		if (l->current == node)
+		{
+			l->current = next;
+			l->index = 0;
+		}
+
+		ulist_unlink(l, node);
+
+		return item;
+	}
+
+	if (next != NULL && node->count < (ULIST_ITEMS >> 1) &&
+		node->count + next->count <= ULIST_ITEMS)
+	{
+		if (l->current == next)
+		{
+			l->current = node;
+			l->index += node->count;
+		}
+
+		memcpy(node->items + node->count, next->items, next->count * sizeof(void*));
+		node->count += next->count;
+		ulist_unlink(l, next);
+	}
+
+	if (l->current == node && l->index == node->count)
+	{
+		l->current = node->next;
+		l->index = 0;
+	}
+
+	return item;
+}
+
+// Returns a new unrolled list with no items, allocated to the heap.
+UnrolledList* newUnrolledList()
+{
+	UnrolledList* l = alloc(UnrolledList, 1);
+
+	l->size = 0;
+	l->first = NULL;
+	l->last = NULL;
+	l->current = NULL;
+	l->index = 0;
+
+	return l;
+}
+
+// Returns the i'th item in the list.
+void* ulist_get(UnrolledList* l, unsigned int index)
+{
+	if (index >= l->size)
+		return NULL;
+
+	UnrolledListNode* node = l->first;
+
+	while (index >= node->count)
+	{
+		index -= node->count;
+		node = node->next;
+	}
+
+	return node->items[index];
+}
+
+// This will add an item to the end of the list.
+void ulist_add(UnrolledList* l, void* data)
+{
+	// A full last node isn't split, the item starts a new node instead.
+	if (l->last == NULL || l->last->count == ULIST_ITEMS)
+		ulist_newNode(l, l->last);
+
+	l->last->items[l->last->count++] = data;
+	l->size++;
+}
+
+// This will add an item to the beginning of the list.
+void ulist_addFirst(UnrolledList* l, void* data)
+{
+	if (l->first == NULL)
+		ulist_newNode(l, NULL);
+
+	ulist_insertAt(l, l->first, 0, data);
+}
+
+// This will remove and return the item on the beginning of the list.
+void* ulist_removeFirst(UnrolledList* l)
+{
+	if (l->size == 0)
+		return NULL;
+
+	return ulist_removeAt(l, l->first, 0);
+}
+
+// Returns true if this list has no items.
+int ulist_isEmpty(UnrolledList* l)
+{
+	return (l->size == 0);
+}
+
+// Starts the traversing of the unrolled list
+void ulist_start(UnrolledList* l)
+{
+	l->current = l->first;
+	l->index = 0;
+}
+
+// During list traversal this will return the current item without going to the next.
+void* ulist_peek(UnrolledList* l)
+{
+	if (l->current == NULL)
+		return NULL;
+
+	return l->current->items[l->index];
+}
+
+// During list traversal this goes to the next item and returns it.
+void* ulist_next(UnrolledList* l)
+{
+	if (l->current == NULL)
+		return NULL;
+
+	void* data = l->current->items[l->index++];
+
+	if (l->index == l->current->count)
+	{
+		l->current = l->current->next;
+		l->index = 0;
+	}
+
+	return data;
+}
+
+// During list traversal this removes the current item from the list and
+// returns it.
+void* ulist_remove(UnrolledList* l)
+{
+	if (l->current == NULL)
+		return NULL;
+
+	return ulist_removeAt(l, l->current, l->index);
+}
+
+// During list traveral this will insert an item before the current item.
+void ulist_insertBefore(UnrolledList* l, void* data)
+{
+	if (l->current == NULL)
+		ulist_add(l, data);
+	else
+		ulist_insertAt(l, l->current, l->index, data);
+}
+
+// During list traveral this will insert an item after the current item.
+void ulist_insertAfter(UnrolledList* l, void* data)
+{
+	if (l->current == NULL)
+		return;
+
+	ulist_insertAt(l, l->current, l->index + 1, data);
+}
+
+// During list traversal this returns whether there are more items 
+// to traverse.
+int ulist_hasNext(UnrolledList* l)
+{
+	return (l->current != NULL);
+}
+
+// Traverses the list from front to back.
+void ulist_traverse(UnrolledList* l, void (*process)(void* item))
+{
+	UnrolledListNode* node;
+	unsigned int i;
+
+	for (node = l->first; node != NULL; node = node->next)
+		for (i = 0; i < node->count; i++)
+			process(node->items[i]);
+}
+
+// Clears the list of all data.
+void ulist_clear(UnrolledList* l)
+{
+	UnrolledListNode* node = l->first;
+	UnrolledListNode* next;
+
+	// Place each node on the pool
+	while (node != NULL)
+	{
+		next = node->next;
+		push_UnrolledListNode(node);
+		node = next;
+	}
+
+	l->first = NULL;
+	l->last = NULL;
+	l->current = NULL;
+	l->index = 0;
+	l->size = 0;
+}
+
+// Removes the list completely from memory.
+void ulist_free(UnrolledList* l)
+{
+	if (l == NULL)
+		return;
+
+	ulist_clear(l);
+	free(l);
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+/*****************************************************************************\
+                  Copyright (C) 2009 Philip Diffenderfer
+
+ This program is free software; you can redistribute it and/or modify it under
+ the terms of the GNU Library General Public License as published by the Free
+ Software Foundation; either version 2 of the License, or any later version.
+
+\*****************************************************************************/
+
+/**
+ * A Chase-Lev work-stealing deque containing generic data. The ordering
+ * of the atomic operations follows "Correct and Efficient Work-Stealing
+ * for Weak Memory Models" by Le, Pop, Cohen, and Zappa Nardelli. The
+ * operations that can be performed on a work-stealing deque are:
+ * 
+ * Push => Adds an item to the bottom of the deque (owner only).
+ * Pop => Removes and returns the item at the bottom of the deque (owner only).
+ * Steal => Removes and returns the item at the top of the deque (any thread).
+ * Size => Returns the number of items in the deque.
+ * Free => Frees the deque from memory.
+ * 
+ * @author Philip Diffenderfer
+ */
+
+#include "util.h"
+#include "wsdeque.h"
+
+// Returns a new ring with the given capacity.
+WorkStealingArray* wsdeque_newArray(long capacity, WorkStealingArray* previous)
+{
+	WorkStealingArray* a = alloc(WorkStealingArray, 1);
+
+	a->capacity = capacity;
+	a->items = alloc(_Atomic(void*), capacity);
+	a->previous = previous;
+
+	return a;
+}
+
+// Returns the item at an index of a ring.
+void* wsdeque_get(WorkStealingArray* a, long index)
+{
+	return atomic_load_explicit(&a->items[index & (a->capacity - 1)], memory_order_relaxed);
+}
+
+// Sets the item at an index of a ring.
+void wsdeque_set(WorkStealingArray* a, long index, void* item)
+{
+	atomic_store_explicit(&a->items[index & (a->capacity - 1)], item, memory_order_relaxed);
+}
+
+// Moves the items from the top to the bottom into a ring twice as large.
+// The old ring is kept since thieves may still be reading from it.
+WorkStealingArray* wsdeque_grow(WorkStealingDeque* d, WorkStealingArray* a, long top, long bottom)
+{
+	WorkStealingArray* grown = wsdeque_newArray(a->capacity << 1, a);
+	long i;
+
+	for (i = top; i < bottom; i++)
+		wsdeque_set(grown, i, wsdeque_get(a, i));
+
+	atomic_store_explicit(&d->array, grown, memory_order_release);
+
+	return grown;
+}
+
+// Returns an empty work-stealing deque allocated to the heap.
+WorkStealingDeque* newWorkStealingDeque(unsigned int capacity)
+{
+	WorkStealingDeque* d;
+
+	if (posix_memalign((void**)&d, CACHE_LINE, sizeof(WorkStealingDeque)) != 0)
+		return NULL;
+
+	// Determine the next size thats a power of 2
+	long actual = 1;
+	while (actual < capacity)
+		actual <<= 1;
+
+	atomic_init(&d->top, 0);
+	atomic_init(&d->bottom, 0);
+	atomic_init(&d->array, wsdeque_newArray(actual, NULL));
+
+	return d;
+}
+
+// Adds an item to the bottom of the deque.
+void wsdeque_push(WorkStealingDeque* d, void* item)
+{
+	long bottom = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+	long top = atomic_load_explicit(&d->top, memory_order_acquire);
+	WorkStealingArray* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+
+	if (bottom - top > a->capacity - 1)
+		a = wsdeque_grow(d, a, top, bottom);
+
+	wsdeque_set(a, bottom, item);
+
+	// Make the item visible before the bottom that includes it.
+	atomic_store_explicit(&d->bottom, bottom + 1, memory_order_release);
+}
+
+// Removes and returns the item at the bottom of the deque.
+void* wsdeque_pop(WorkStealingDeque* d)
+{
+	long bottom = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+	WorkStealingArray* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+
+	// Claim the bottom item before looking at the top, so a thief either
+	// sees the claim or the owner sees the thief's steal.
+	atomic_store_explicit(&d->bottom, bottom, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+
+	long top = atomic_load_explicit(&d->top, memory_order_relaxed);
+	void* item = NULL;
+
+	if (top <= bottom)
+	{
+		item = wsdeque_get(a, bottom);
+
+		// The last item may be wanted by a thief too, race it for the top.
+		if (top == bottom)
+		{
+			if (!atomic_compare_exchange_strong_explicit(&d->top, &top, top + 1,
+				memory_order_seq_cst, memory_order_relaxed))
+				item = NULL;
+
+			atomic_store_explicit(&d->bottom, bottom + 1, memory_order_relaxed);
+		}
+	}
+	else
+	{
+		atomic_store_explicit(&d->bottom, bottom + 1, memory_order_relaxed);
+	}
+
+	return item;
+}
+
+// Removes and returns the item at the top of the deque.
+void* wsdeque_steal(WorkStealingDeque* d)
+{
+	long top = atomic_load_explicit(&d->top, memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	long bottom = atomic_load_explicit(&d->bottom, memory_order_acquire);
+
+	if (top >= bottom)
+		return NULL;
+
+	WorkStealingArray* a = atomic_load_explicit(&d->array, memory_order_acquire);
+	void* item = wsdeque_get(a, top);
+
+	if (!atomic_compare_exchange_strong_explicit(&d->top, &top, top + 1,
+		memory_order_seq_cst, memory_order_relaxed))
+		return NULL;
+
+	return item;
+}
+
+// Returns the number of items in the deque.
+unsigned int wsdeque_size(WorkStealingDeque* d)
+{
+	long bottom = atomic_load_explicit(&d->bottom, memory_order_acquire);
+	long top = atomic_load_explicit(&d->top, memory_order_acquire);
+
+	return (unsigned int)(bottom > top ? bottom - top : 0);
+}
+
+// Returns true if the deque has no items.
+int wsdeque_isEmpty(WorkStealingDeque* d)
+{
+	return (wsdeque_size(d) == 0);
+}
+
+// Removes the deque and every ring it has used completely from memory.
+void wsdeque_free(WorkStealingDeque* d)
+{
+	if (d == NULL)
+		return;
+
+	WorkStealingArray* a = atomic_load_explicit(&d->array, memory_order_relaxed);
+	WorkStealingArray* previous;
+
+	while (a != NULL)
+	{
+		previous = a->previous;
+		free(a->items);
+		free(a);
+		a = previous;
+	}
+
+	free(d);
+}
\ No newline at end of file